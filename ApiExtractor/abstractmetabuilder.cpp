@@ -316,6 +316,18 @@ void AbstractMetaBuilder::sortLists()
         cls->sortFunctions();
 }
 
+FileModelItem AbstractMetaBuilder::parse(CodeModel* model, const char* contents, std::size_t size)
+{
+    Control control;
+    Parser p(&control);
+    pool __pool;
+
+    TranslationUnitAST* ast = p.parse(contents, size, &__pool);
+
+    Binder binder(model, p.location());
+    return binder.run(ast);
+}
+
 bool AbstractMetaBuilder::build(QIODevice* input)
 {
     Q_ASSERT(input);
@@ -325,20 +337,36 @@ bool AbstractMetaBuilder::build(QIODevice* input)
             return false;
     }
 
-    TypeDatabase* types = TypeDatabase::instance();
-
     QByteArray contents = input->readAll();
     input->close();
 
-    Control control;
-    Parser p(&control);
-    pool __pool;
+    return build(contents.constData(), contents.size());
+}
+
+bool AbstractMetaBuilder::build(const char* contents, std::size_t size)
+{
+    CodeModel model;
+    m_dom = parse(&model, contents, size);
+
+    return traverseDom();
+}
 
-    TranslationUnitAST* ast = p.parse(contents, contents.size(), &__pool);
+bool AbstractMetaBuilder::build(const FileList& translationUnits)
+{
+    if (translationUnits.isEmpty())
+        return false;
 
     CodeModel model;
-    Binder binder(&model, p.location());
-    m_dom = binder.run(ast);
+    m_dom = model.create<FileModelItem>();
+    foreach (FileModelItem unit, translationUnits)
+        m_dom->merge(model_static_cast<NamespaceModelItem>(unit));
+
+    return traverseDom();
+}
+
+bool AbstractMetaBuilder::traverseDom()
+{
+    TypeDatabase* types = TypeDatabase::instance();
 
     pushScope(model_dynamic_cast<ScopeModelItem>(m_dom));
 
@@ -2648,6 +2676,8 @@ bool AbstractMetaBuilder::inheritTemplate(AbstractMetaClass* subclass,
 #endif
             te->addFunctionModification(mod);
         }
+        if (!mods.isEmpty())
+            AbstractMetaFunction::invalidateModificationCaches();
 
         subclass->addFunction(f);
     }
@@ -2951,12 +2981,22 @@ AbstractMetaArgumentList AbstractMetaBuilder::reverseList(const AbstractMetaArgu
 
 void AbstractMetaBuilder::setGlobalHeader(const QString& globalHeader)
 {
-    m_globalHeader = QFileInfo(globalHeader);
+    setGlobalHeaders(QStringList(globalHeader));
+}
+
+void AbstractMetaBuilder::setGlobalHeaders(const QStringList& globalHeaders)
+{
+    m_globalHeaders.clear();
+    foreach (const QString& globalHeader, globalHeaders)
+        m_globalHeaders << QFileInfo(globalHeader);
 }
 
 void AbstractMetaBuilder::setInclude(TypeEntry* te, const QString& fileName) const
 {
     QFileInfo info(fileName);
-    if (m_globalHeader.fileName() != info.fileName())
-        te->setInclude(Include(Include::IncludePath, info.fileName()));
+    foreach (const QFileInfo& globalHeader, m_globalHeaders) {
+        if (globalHeader.fileName() == info.fileName())
+            return;
+    }
+    te->setInclude(Include(Include::IncludePath, info.fileName()));
 }
@@ -94,6 +94,20 @@ public:
     void dumpLog();
 
     bool build(QIODevice* input);
+    /**
+    *   Builds the meta model out of a preprocessed buffer held in memory.
+    */
+    bool build(const char* contents, std::size_t size);
+    /**
+    *   Builds the meta model out of translation units parsed independently
+    *   (see parse()), their code models are merged before being traversed.
+    */
+    bool build(const FileList& translationUnits);
+    /**
+    *   Lexes, parses and binds a preprocessed translation unit. Each call only
+    *   touches its own \p model, so units may be parsed on different threads.
+    */
+    static FileModelItem parse(CodeModel* model, const char* contents, std::size_t size);
     void setLogDirectory(const QString& logDir);
 
     void figureOutEnumValuesForClass(AbstractMetaClass *metaClass, QSet<AbstractMetaClass *> *classes);
@@ -189,8 +203,10 @@ public:
     *   filled.
     */
     void setGlobalHeader(const QString& globalHeader);
+    void setGlobalHeaders(const QStringList& globalHeaders);
 
 protected:
+    bool traverseDom();
     AbstractMetaClass *argumentToClass(ArgumentModelItem);
 
     virtual AbstractMetaClass *createMetaClass()
@@ -265,7 +281,7 @@ private:
     QSet<QString> m_qmetatypeDeclaredTypenames;
 
     QString m_logDirectory;
-    QFileInfo m_globalHeader;
+    QList<QFileInfo> m_globalHeaders;
 };
 
 #endif // ABSTRACTMETBUILDER_H
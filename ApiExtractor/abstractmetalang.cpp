@@ -458,14 +458,15 @@ QList<ReferenceCount> AbstractMetaFunction::referenceCounts(const AbstractMetaCl
 {
     QList<ReferenceCount> returned;
 
-    FunctionModificationList mods = this->modifications(cls);
-    foreach (FunctionModification mod, mods) {
-        QList<ArgumentModification> argumentMods = mod.argument_mods;
-        foreach (ArgumentModification argumentMod, argumentMods) {
-            if (argumentMod.index != idx && idx != -2)
-                continue;
+    if (idx != -2) {
+        foreach (const ArgumentModification &argumentMod, argumentModifications(cls, idx))
+            returned += argumentMod.referenceCounts;
+        return returned;
+    }
+
+    foreach (const FunctionModification &mod, modifications(cls)) {
+        foreach (const ArgumentModification &argumentMod, mod.argument_mods)
             returned += argumentMod.referenceCounts;
-        }
     }
 
     return returned;
@@ -474,30 +475,18 @@ QList<ReferenceCount> AbstractMetaFunction::referenceCounts(const AbstractMetaCl
 
 ArgumentOwner AbstractMetaFunction::argumentOwner(const AbstractMetaClass *cls, int idx) const
 {
-    FunctionModificationList mods = this->modifications(cls);
-    foreach (FunctionModification mod, mods) {
-        QList<ArgumentModification> argumentMods = mod.argument_mods;
-        foreach (ArgumentModification argumentMod, argumentMods) {
-            if (argumentMod.index != idx)
-                continue;
-            return argumentMod.owner;
-        }
-    }
+    QList<ArgumentModification> argumentMods = argumentModifications(cls, idx);
+    if (!argumentMods.isEmpty())
+        return argumentMods.first().owner;
     return ArgumentOwner();
 }
 
 
 QString AbstractMetaFunction::replacedDefaultExpression(const AbstractMetaClass *cls, int key) const
 {
-    FunctionModificationList modifications = this->modifications(cls);
-    foreach (FunctionModification modification, modifications) {
-        QList<ArgumentModification> argumentModifications = modification.argument_mods;
-        foreach (ArgumentModification argumentModification, argumentModifications) {
-            if (argumentModification.index == key
-                && !argumentModification.replacedDefaultExpression.isEmpty()) {
-                return argumentModification.replacedDefaultExpression;
-            }
-        }
+    foreach (const ArgumentModification &argumentModification, argumentModifications(cls, key)) {
+        if (!argumentModification.replacedDefaultExpression.isEmpty())
+            return argumentModification.replacedDefaultExpression;
     }
 
     return QString();
@@ -505,15 +494,9 @@ QString AbstractMetaFunction::replacedDefaultExpression(const AbstractMetaClass
 
 bool AbstractMetaFunction::removedDefaultExpression(const AbstractMetaClass *cls, int key) const
 {
-    FunctionModificationList modifications = this->modifications(cls);
-    foreach (FunctionModification modification, modifications) {
-        QList<ArgumentModification> argumentModifications = modification.argument_mods;
-        foreach (ArgumentModification argumentModification, argumentModifications) {
-            if (argumentModification.index == key
-                && argumentModification.removedDefaultExpression) {
-                return true;
-            }
-        }
+    foreach (const ArgumentModification &argumentModification, argumentModifications(cls, key)) {
+        if (argumentModification.removedDefaultExpression)
+            return true;
     }
 
     return false;
@@ -521,14 +504,19 @@ bool AbstractMetaFunction::removedDefaultExpression(const AbstractMetaClass *cls
 
 bool AbstractMetaFunction::resetObjectAfterUse(int argumentIdx) const
 {
-    const AbstractMetaClass *cls = declaringClass();
-    FunctionModificationList modifications = this->modifications(cls);
-    foreach (FunctionModification modification, modifications) {
-        QList<ArgumentModification> argumentModifications = modification.argument_mods;
-        foreach (ArgumentModification argumentModification, argumentModifications) {
-            if (argumentModification.index == argumentIdx && argumentModification.resetAfterUse)
-                return true;
-        }
+    foreach (const ArgumentModification &argumentModification, argumentModifications(declaringClass(), argumentIdx)) {
+        if (argumentModification.resetAfterUse)
+            return true;
+    }
+
+    return false;
+}
+
+bool AbstractMetaFunction::returnsContainerView() const
+{
+    foreach (const ArgumentModification &argumentModification, argumentModifications(declaringClass(), 0)) {
+        if (argumentModification.view)
+            return true;
     }
 
     return false;
@@ -543,15 +531,9 @@ QString AbstractMetaFunction::nullPointerDefaultValue(const AbstractMetaClass *m
         cls = implementingClass();
 
     do {
-        FunctionModificationList modifications = this->modifications(cls);
-        foreach (FunctionModification modification, modifications) {
-            QList<ArgumentModification> argumentModifications = modification.argument_mods;
-            foreach (ArgumentModification argumentModification, argumentModifications) {
-                if (argumentModification.index == argumentIdx
-                    && argumentModification.noNullPointers) {
-                    return argumentModification.nullPointerDefaultValue;
-                }
-            }
+        foreach (const ArgumentModification &argumentModification, argumentModifications(cls, argumentIdx)) {
+            if (argumentModification.noNullPointers)
+                return argumentModification.nullPointerDefaultValue;
         }
         cls = cls->baseClass();
     } while (cls && !mainClass); // Once when mainClass, or once for all base classes of implementing class
@@ -567,15 +549,9 @@ bool AbstractMetaFunction::nullPointersDisabled(const AbstractMetaClass *mainCla
         cls = implementingClass();
 
     do {
-        FunctionModificationList modifications = this->modifications(cls);
-        foreach (FunctionModification modification, modifications) {
-            QList<ArgumentModification> argumentModifications = modification.argument_mods;
-            foreach (ArgumentModification argumentModification, argumentModifications) {
-                if (argumentModification.index == argumentIdx
-                    && argumentModification.noNullPointers) {
-                    return true;
-                }
-            }
+        foreach (const ArgumentModification &argumentModification, argumentModifications(cls, argumentIdx)) {
+            if (argumentModification.noNullPointers)
+                return true;
         }
 
         cls = cls->baseClass();
@@ -586,17 +562,10 @@ bool AbstractMetaFunction::nullPointersDisabled(const AbstractMetaClass *mainCla
 
 QString AbstractMetaFunction::conversionRule(TypeSystem::Language language, int key) const
 {
-    FunctionModificationList modifications = this->modifications(declaringClass());
-    foreach (FunctionModification modification, modifications) {
-        QList<ArgumentModification> argumentModifications = modification.argument_mods;
-        foreach (ArgumentModification argumentModification, argumentModifications) {
-            if (argumentModification.index != key)
-                continue;
-
-            foreach (CodeSnip snip, argumentModification.conversion_rules) {
-                if (snip.language == language && !snip.code().isEmpty())
-                    return snip.code();
-            }
+    foreach (const ArgumentModification &argumentModification, argumentModifications(declaringClass(), key)) {
+        foreach (CodeSnip snip, argumentModification.conversion_rules) {
+            if (snip.language == language && !snip.code().isEmpty())
+                return snip.code();
         }
     }
 
@@ -605,13 +574,9 @@ QString AbstractMetaFunction::conversionRule(TypeSystem::Language language, int
 
 QString AbstractMetaFunction::argumentReplaced(int key) const
 {
-    FunctionModificationList modifications = this->modifications(declaringClass());
-    foreach (FunctionModification modification, modifications) {
-        QList<ArgumentModification>& argumentModifications = modification.argument_mods;
-        foreach (ArgumentModification argumentModification, argumentModifications) {
-            if (argumentModification.index == key && !argumentModification.replace_value.isEmpty())
-                return argumentModification.replace_value;
-        }
+    foreach (const ArgumentModification &argumentModification, argumentModifications(declaringClass(), key)) {
+        if (!argumentModification.replace_value.isEmpty())
+            return argumentModification.replace_value;
     }
 
     return "";
@@ -620,15 +585,9 @@ QString AbstractMetaFunction::argumentReplaced(int key) const
 // FIXME If we remove a arg. in the method at the base class, it will not reflect here.
 bool AbstractMetaFunction::argumentRemoved(int key) const
 {
-    FunctionModificationList modifications = this->modifications(declaringClass());
-    foreach (FunctionModification modification, modifications) {
-        QList<ArgumentModification> argumentModifications = modification.argument_mods;
-        foreach (ArgumentModification argumentModification, argumentModifications) {
-            if (argumentModification.index == key) {
-                if (argumentModification.removed)
-                    return true;
-            }
-        }
+    foreach (const ArgumentModification &argumentModification, argumentModifications(declaringClass(), key)) {
+        if (argumentModification.removed)
+            return true;
     }
 
     return false;
@@ -647,18 +606,10 @@ bool AbstractMetaFunction::isVirtualSlot() const
 
 bool AbstractMetaFunction::disabledGarbageCollection(const AbstractMetaClass *cls, int key) const
 {
-    FunctionModificationList modifications = this->modifications(cls);
-    foreach (FunctionModification modification, modifications) {
-        QList<ArgumentModification> argumentModifications = modification.argument_mods;
-        foreach (ArgumentModification argumentModification, argumentModifications) {
-            if (argumentModification.index != key)
-                continue;
-
-            foreach (TypeSystem::Ownership ownership, argumentModification.ownerships.values()) {
-                if (ownership == TypeSystem::CppOwnership)
-                    return true;
-            }
-
+    foreach (const ArgumentModification &argumentModification, argumentModifications(cls, key)) {
+        foreach (TypeSystem::Ownership ownership, argumentModification.ownerships.values()) {
+            if (ownership == TypeSystem::CppOwnership)
+                return true;
         }
     }
 
@@ -698,14 +649,9 @@ bool AbstractMetaFunction::allowThread() const
 
 TypeSystem::Ownership AbstractMetaFunction::ownership(const AbstractMetaClass *cls, TypeSystem::Language language, int key) const
 {
-    FunctionModificationList modifications = this->modifications(cls);
-    foreach (FunctionModification modification, modifications) {
-        QList<ArgumentModification> argumentModifications = modification.argument_mods;
-        foreach (ArgumentModification argumentModification, argumentModifications) {
-            if (argumentModification.index == key)
-                return argumentModification.ownerships.value(language, TypeSystem::InvalidOwnership);
-        }
-    }
+    QList<ArgumentModification> argumentMods = argumentModifications(cls, key);
+    if (!argumentMods.isEmpty())
+        return argumentMods.first().ownerships.value(language, TypeSystem::InvalidOwnership);
 
     return TypeSystem::InvalidOwnership;
 }
@@ -729,15 +675,9 @@ bool AbstractMetaFunction::isRemovedFrom(const AbstractMetaClass *cls, TypeSyste
 
 QString AbstractMetaFunction::typeReplaced(int key) const
 {
-    FunctionModificationList modifications = this->modifications(declaringClass());
-    foreach (FunctionModification modification, modifications) {
-        QList<ArgumentModification> argumentModifications = modification.argument_mods;
-        foreach (ArgumentModification argumentModification, argumentModifications) {
-            if (argumentModification.index == key
-                && !argumentModification.modified_type.isEmpty()) {
-                return argumentModification.modified_type;
-            }
-        }
+    foreach (const ArgumentModification &argumentModification, argumentModifications(declaringClass(), key)) {
+        if (!argumentModification.modified_type.isEmpty())
+            return argumentModification.modified_type;
     }
 
     return QString();
@@ -769,26 +709,80 @@ QString AbstractMetaFunction::minimalSignature() const
     return minimalSignature;
 }
 
-FunctionModificationList AbstractMetaFunction::modifications(const AbstractMetaClass* implementor) const
+QAtomicInt AbstractMetaFunction::m_modificationsRevision(0);
+QAtomicInt AbstractMetaFunction::m_modificationCachesFrozen(0);
+
+void AbstractMetaFunction::invalidateModificationCaches()
+{
+    m_modificationsRevision.fetchAndAddRelease(1);
+}
+
+void AbstractMetaFunction::setModificationCachesFrozen(bool frozen)
+{
+    m_modificationCachesFrozen.fetchAndStoreRelease(frozen ? 1 : 0);
+}
+
+void AbstractMetaFunction::fillModificationCache(const AbstractMetaClass *implementor) const
+{
+    cachedModifications(0);
+    cachedModifications(implementingClass());
+    cachedModifications(declaringClass());
+    if (implementor)
+        cachedModifications(implementor);
+}
+
+AbstractMetaFunction::ModificationCacheEntry AbstractMetaFunction::cachedModifications(const AbstractMetaClass *implementor) const
 {
     if (!implementor)
         implementor = ownerClass();
 
-    if (!implementor)
-        return TypeDatabase::instance()->functionModifications(minimalSignature());
+    int revision = m_modificationsRevision.fetchAndAddAcquire(0);
+    if (m_modificationCacheRevision == revision) {
+        QHash<const AbstractMetaClass *, ModificationCacheEntry>::const_iterator it = m_modificationCache.constFind(implementor);
+        if (it != m_modificationCache.constEnd())
+            return it.value();
+    }
 
-    FunctionModificationList mods;
-    while (implementor) {
-        mods += implementor->typeEntry()->functionModifications(minimalSignature());
-        if ((implementor == implementor->baseClass()) ||
-            (implementor == implementingClass() && (mods.size() > 0)))
-                break;
-        foreach (const AbstractMetaClass* interface, implementor->interfaces()) {
-            mods += this->modifications(interface);
+    ModificationCacheEntry entry;
+    if (!implementor) {
+        entry.modifications = TypeDatabase::instance()->functionModifications(minimalSignature());
+    } else {
+        const AbstractMetaClass *cls = implementor;
+        while (cls) {
+            entry.modifications += cls->typeEntry()->functionModifications(minimalSignature());
+            if ((cls == cls->baseClass()) ||
+                (cls == implementingClass() && (entry.modifications.size() > 0)))
+                    break;
+            foreach (const AbstractMetaClass* interface, cls->interfaces())
+                entry.modifications += cachedModifications(interface).modifications;
+            cls = cls->baseClass();
         }
-        implementor = implementor->baseClass();
     }
-    return mods;
+
+    foreach (const FunctionModification &mod, entry.modifications) {
+        foreach (const ArgumentModification &argumentMod, mod.argument_mods)
+            entry.argumentModifications[argumentMod.index] << argumentMod;
+    }
+
+    // Frozen caches may be read by several threads at once, the entry is just not kept.
+    if (!m_modificationCachesFrozen.fetchAndAddAcquire(0)) {
+        if (m_modificationCacheRevision != revision) {
+            m_modificationCache.clear();
+            m_modificationCacheRevision = revision;
+        }
+        m_modificationCache.insert(implementor, entry);
+    }
+    return entry;
+}
+
+QList<ArgumentModification> AbstractMetaFunction::argumentModifications(const AbstractMetaClass *implementor, int index) const
+{
+    return cachedModifications(implementor).argumentModifications.value(index);
+}
+
+FunctionModificationList AbstractMetaFunction::modifications(const AbstractMetaClass* implementor) const
+{
+    return cachedModifications(implementor).modifications;
 }
 
 bool AbstractMetaFunction::hasModifications(const AbstractMetaClass *implementor) const
@@ -1480,6 +1474,7 @@ void AbstractMetaClass::setBaseClass(AbstractMetaClass *baseClass)
     m_baseClass = baseClass;
     if (baseClass)
         m_isPolymorphic |= baseClass->isPolymorphic();
+    AbstractMetaFunction::invalidateModificationCaches();
 }
 
 bool AbstractMetaClass::hasFunction(const QString &str) const
@@ -1929,6 +1924,7 @@ void AbstractMetaClass::addInterface(AbstractMetaClass *interface)
 {
     Q_ASSERT(!m_interfaces.contains(interface));
     m_interfaces << interface;
+    AbstractMetaFunction::invalidateModificationCaches();
 
     m_isPolymorphic |= interface->isPolymorphic();
 
@@ -1968,6 +1964,7 @@ void AbstractMetaClass::setInterfaces(const AbstractMetaClassList &interfaces)
         if (interface)
             m_isPolymorphic |= interface->isPolymorphic();
     }
+    AbstractMetaFunction::invalidateModificationCaches();
 }
 
 
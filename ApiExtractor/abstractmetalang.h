@@ -26,6 +26,7 @@
 
 #include "typesystem.h"
 
+#include <QtCore/QAtomicInt>
 #include <QtCore/QSet>
 #include <QtCore/QStringList>
 #include <QtCore/QTextStream>
@@ -808,7 +809,8 @@ public:
             m_userAdded(false),
             m_explicit(false),
             m_pointerOperator(false),
-            m_isCallOperator(false)
+            m_isCallOperator(false),
+            m_modificationCacheRevision(0)
     {
     }
 
@@ -953,6 +955,7 @@ public:
     void setOwnerClass(const AbstractMetaClass *cls)
     {
         m_class = cls;
+        m_modificationCache.clear();
     }
 
     // The first class in a hierarchy that declares the function
@@ -973,6 +976,7 @@ public:
     void setImplementingClass(const AbstractMetaClass *cls)
     {
         m_implementingClass = cls;
+        m_modificationCache.clear();
     }
 
     bool needsCallThrough() const;
@@ -1090,6 +1094,9 @@ public:
 
     bool resetObjectAfterUse(int argument_idx) const;
 
+    // Returns whether a returned container is given to Python as a read-only view
+    bool returnsContainerView() const;
+
     // Returns whether garbage collection is disabled for the argument in any context
     bool disabledGarbageCollection(const AbstractMetaClass *cls, int key) const;
 
@@ -1128,6 +1135,26 @@ public:
     bool hasSignatureModifications() const;
     FunctionModificationList modifications(const AbstractMetaClass* implementor = 0) const;
 
+    /**
+    *   Discards the modifications cached by every function. Must be called
+    *   whenever the class hierarchy or the type system modifications change
+    *   after functions may already have been queried.
+    */
+    static void invalidateModificationCaches();
+
+    /**
+    *   Fills the modification caches of the function for its owner, implementing
+    *   and declaring classes, and for \p implementor if given.
+    */
+    void fillModificationCache(const AbstractMetaClass *implementor = 0) const;
+
+    /**
+    *   While frozen the modification caches are only read, modifications missing
+    *   from them are computed again on each query. Several threads may then query
+    *   the modifications of the same functions; fill the caches before freezing them.
+    */
+    static void setModificationCachesFrozen(bool frozen);
+
     /**
      * Return the argument name if there is a modification the renamed value will be returned
      */
@@ -1167,6 +1194,16 @@ public:
 
     bool isCallOperator() const;
 private:
+    struct ModificationCacheEntry
+    {
+        FunctionModificationList modifications;
+        // Argument modifications of the list above, grouped by argument index
+        QHash<int, QList<ArgumentModification> > argumentModifications;
+    };
+
+    ModificationCacheEntry cachedModifications(const AbstractMetaClass *implementor) const;
+    QList<ArgumentModification> argumentModifications(const AbstractMetaClass *implementor, int index) const;
+
     QString m_name;
     QString m_originalName;
     mutable QString m_cachedMinimalSignature;
@@ -1189,6 +1226,11 @@ private:
     uint m_explicit                 : 1;
     uint m_pointerOperator          : 1;
     uint m_isCallOperator           : 1;
+
+    mutable QHash<const AbstractMetaClass *, ModificationCacheEntry> m_modificationCache;
+    mutable int m_modificationCacheRevision;
+    static QAtomicInt m_modificationsRevision;
+    static QAtomicInt m_modificationCachesFrozen;
 };
 
 
@@ -24,7 +24,8 @@
 #include "apiextractor.h"
 #include <QDir>
 #include <QDebug>
-#include <QTemporaryFile>
+#include <QSharedPointer>
+#include <QtConcurrentMap>
 #include <iostream>
 
 #include "reporthandler.h"
@@ -35,8 +36,11 @@
 #include "typedatabase.h"
 
 static bool preprocess(const QString& sourceFile,
-                       QFile& targetFile,
+                       std::string& result,
                        const QStringList& includes);
+static void writePreprocessedFile(const QString& sourceFile,
+                                  const std::string& contents,
+                                  const QString& directory);
 
 ApiExtractor::ApiExtractor() : m_builder(0)
 {
@@ -83,7 +87,12 @@ void ApiExtractor::setLogDirectory(const QString& logDir)
 
 void ApiExtractor::setCppFileName(const QString& cppFileName)
 {
-    m_cppFileName = cppFileName;
+    m_cppFileNames = QStringList(cppFileName);
+}
+
+void ApiExtractor::setCppFileNames(const QStringList& cppFileNames)
+{
+    m_cppFileNames = cppFileNames;
 }
 
 void ApiExtractor::setTypeSystem(const QString& typeSystemFileName)
@@ -216,6 +225,46 @@ int ApiExtractor::classCount() const
     return m_builder->classes().count();
 }
 
+namespace {
+
+struct TranslationUnit
+{
+    QString fileName;
+    QSharedPointer<CodeModel> model;
+    FileModelItem dom;
+};
+
+class TranslationUnitParser
+{
+public:
+    typedef TranslationUnit result_type;
+
+    TranslationUnitParser(const QStringList& includes, const QString& logDirectory)
+        : m_includes(includes), m_logDirectory(logDirectory) {}
+
+    TranslationUnit operator()(const QString& fileName) const
+    {
+        TranslationUnit unit;
+        unit.fileName = fileName;
+
+        std::string contents;
+        if (!preprocess(fileName, contents, m_includes))
+            return unit;
+        if (ReportHandler::debugLevel() == ReportHandler::FullDebug)
+            writePreprocessedFile(fileName, contents, m_logDirectory);
+
+        unit.model = QSharedPointer<CodeModel>(new CodeModel);
+        unit.dom = AbstractMetaBuilder::parse(unit.model.data(), contents.c_str(), contents.size());
+        return unit;
+    }
+
+private:
+    QStringList m_includes;
+    QString m_logDirectory;
+};
+
+}
+
 bool ApiExtractor::run()
 {
     if (m_builder)
@@ -229,26 +278,57 @@ bool ApiExtractor::run()
         return false;
     }
 
-    QTemporaryFile ppFile;
-#ifndef NDEBUG
-    ppFile.setAutoRemove(false);
-#endif
-    // run rpp pre-processor
-    if (!preprocess(m_cppFileName, ppFile, m_includePaths)) {
-        std::cerr << "Preprocessor failed on file: " << qPrintable(m_cppFileName);
+    if (m_cppFileNames.isEmpty()) {
+        std::cerr << "You must specify a header file." << std::endl;
+        return false;
+    }
+
+    if (m_cppFileNames.size() > 1)
+        return runTranslationUnits();
+
+    const QString cppFileName = m_cppFileNames.first();
+    // run rpp pre-processor, its output goes straight to the parser
+    std::string contents;
+    if (!preprocess(cppFileName, contents, m_includePaths)) {
+        std::cerr << "Preprocessor failed on file: " << qPrintable(cppFileName);
         return false;
     }
-    ppFile.seek(0);
+    if (ReportHandler::debugLevel() == ReportHandler::FullDebug)
+        writePreprocessedFile(cppFileName, contents, m_logDirectory);
+
     m_builder = new AbstractMetaBuilder;
     m_builder->setLogDirectory(m_logDirectory);
-    m_builder->setGlobalHeader(m_cppFileName);
-    m_builder->build(&ppFile);
+    m_builder->setGlobalHeader(cppFileName);
+    m_builder->build(contents.c_str(), contents.size());
+
+    return true;
+}
+
+bool ApiExtractor::runTranslationUnits()
+{
+    // Every header is preprocessed, lexed and parsed independently on the global thread pool.
+    QList<TranslationUnit> units = QtConcurrent::blockingMapped(m_cppFileNames,
+                                                                 TranslationUnitParser(m_includePaths, m_logDirectory));
+
+    FileList translationUnits;
+    foreach (const TranslationUnit& unit, units) {
+        if (!unit.dom) {
+            std::cerr << "Preprocessor failed on file: " << qPrintable(unit.fileName);
+            return false;
+        }
+        translationUnits << unit.dom;
+    }
+
+    m_builder = new AbstractMetaBuilder;
+    m_builder->setLogDirectory(m_logDirectory);
+    m_builder->setGlobalHeaders(m_cppFileNames);
+    m_builder->build(translationUnits);
 
     return true;
 }
 
 static bool preprocess(const QString& sourceFile,
-                       QFile& targetFile,
+                       std::string& result,
                        const QStringList& includes)
 {
     rpp::pp_environment env;
@@ -268,38 +348,38 @@ static bool preprocess(const QString& sourceFile,
     file.close();
     preprocess.operator()(ba.constData(), ba.constData() + ba.size(), null_out);
 
-    preprocess.push_include_path(".");
-    foreach (QString include, includes)
-        preprocess.push_include_path(QDir::convertSeparators(include).toStdString());
-    preprocess.push_include_path("/usr/include");
-
-    QString currentDir = QDir::current().absolutePath();
     QFileInfo sourceInfo(sourceFile);
     if (!sourceInfo.exists()) {
         std::cerr << "File not found " << qPrintable(sourceFile) << std::endl;
         return false;
     }
-    QDir::setCurrent(sourceInfo.absolutePath());
 
-    std::string result;
-    result.reserve(20 * 1024);  // 20K
+    // The source directory takes the place of ".", the working directory is
+    // process wide and must not be changed while other headers are being parsed.
+    preprocess.push_include_path(QDir::convertSeparators(sourceInfo.absolutePath()).toStdString());
+    foreach (QString include, includes)
+        preprocess.push_include_path(QDir::convertSeparators(sourceInfo.absoluteDir().absoluteFilePath(include)).toStdString());
+    preprocess.push_include_path("/usr/include");
 
     result += "# 1 \"builtins\"\n";
     result += "# 1 \"";
     result += sourceFile.toStdString();
     result += "\"\n";
 
-    preprocess.file(sourceInfo.fileName().toStdString(),
+    preprocess.file(QDir::convertSeparators(sourceInfo.absoluteFilePath()).toStdString(),
                     rpp::pp_output_iterator<std::string> (result));
+    return true;
+}
 
-    QDir::setCurrent(currentDir);
-
-    if (!targetFile.open(QIODevice::ReadWrite | QIODevice::Text)) {
+static void writePreprocessedFile(const QString& sourceFile,
+                                  const std::string& contents,
+                                  const QString& directory)
+{
+    QFile targetFile(QDir(directory).filePath(QFileInfo(sourceFile).fileName() + ".pp"));
+    if (!targetFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
         std::cerr << "Failed to write preprocessed file: " << qPrintable(targetFile.fileName()) << std::endl;
-        return false;
+        return;
     }
 
-    targetFile.write(result.c_str(), result.length());
-    return true;
+    targetFile.write(contents.c_str(), contents.length());
 }
-
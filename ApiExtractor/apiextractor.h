@@ -40,6 +40,11 @@ public:
 
     void setTypeSystem(const QString& typeSystemFileName);
     void setCppFileName(const QString& cppFileName);
+    /**
+     *   Sets several global headers, each one is preprocessed and parsed
+     *   on its own thread and the results are merged into a single code model.
+     */
+    void setCppFileNames(const QStringList& cppFileNames);
     void setDebugLevel(ReportHandler::DebugLevel debugLevel);
     void setSuppressWarnings(bool value);
     void setSilent(bool value);
@@ -68,8 +73,10 @@ public:
 
     bool run();
 private:
+    bool runTranslationUnits();
+
     QString m_typeSystemFileName;
-    QString m_cppFileName;
+    QStringList m_cppFileNames;
     QStringList m_includePaths;
     AbstractMetaBuilder* m_builder;
     QString m_logDirectory;
@@ -0,0 +1,129 @@
+/*
+ * This file is part of the API Extractor project.
+ *
+ * Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#include "codesniptemplate.h"
+
+static inline bool isIdentifierStart(QChar c)
+{
+    return c.isLetter() || c == '_';
+}
+
+static inline bool isIdentifierChar(QChar c)
+{
+    return c.isLetterOrNumber() || c == '_';
+}
+
+CodeSnipTemplate::CodeSnipTemplate(const QString& code)
+{
+    const int size = code.size();
+    int literalStart = 0;
+    int pos = 0;
+    while (pos < size) {
+        pos = code.indexOf('%', pos);
+        if (pos == -1)
+            break;
+
+        int end = pos + 1;
+        if (end < size && code.at(end).isDigit()) {
+            while (end < size && code.at(end).isDigit())
+                ++end;
+        } else if (end < size && isIdentifierStart(code.at(end))) {
+            while (end < size && isIdentifierChar(code.at(end)))
+                ++end;
+        } else {
+            // A lone '%' or "%%": literal text.
+            pos = end;
+            continue;
+        }
+
+        if (pos > literalStart) {
+            Token literal;
+            literal.kind = Token::Literal;
+            literal.text = code.mid(literalStart, pos - literalStart);
+            m_tokens << literal;
+        }
+        Token variable;
+        variable.kind = Token::Variable;
+        variable.text = code.mid(pos + 1, end - pos - 1);
+        m_tokens << variable;
+        m_variables << variable.text;
+
+        pos = literalStart = end;
+    }
+
+    if (literalStart < size) {
+        Token literal;
+        literal.kind = Token::Literal;
+        literal.text = code.mid(literalStart);
+        m_tokens << literal;
+    }
+}
+
+int CodeSnipTemplate::count(const QString& name) const
+{
+    if (!uses(name))
+        return 0;
+    int result = 0;
+    foreach (const Token& token, m_tokens) {
+        if (token.kind == Token::Variable && token.text == name)
+            ++result;
+    }
+    return result;
+}
+
+QString CodeSnipTemplate::render(const QHash<QString, QString>& values) const
+{
+    QString result;
+    bool skipDot = false;
+    for (int i = 0; i < m_tokens.size(); ++i) {
+        const Token& token = m_tokens.at(i);
+        if (token.kind == Token::Literal) {
+            if (skipDot)
+                result += token.text.mid(1);
+            else
+                result += token.text;
+            skipDot = false;
+            continue;
+        }
+        skipDot = false;
+
+        bool followedByDot = i + 1 < m_tokens.size()
+                             && m_tokens.at(i + 1).kind == Token::Literal
+                             && m_tokens.at(i + 1).text.startsWith('.');
+        if (followedByDot) {
+            QHash<QString, QString>::const_iterator it = values.constFind(token.text + '.');
+            if (it != values.constEnd()) {
+                result += it.value();
+                skipDot = true;
+                continue;
+            }
+        }
+
+        QHash<QString, QString>::const_iterator it = values.constFind(token.text);
+        if (it != values.constEnd())
+            result += it.value();
+        else
+            result += '%' + token.text;
+    }
+    return result;
+}
@@ -0,0 +1,81 @@
+/*
+ * This file is part of the API Extractor project.
+ *
+ * Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#ifndef CODESNIPTEMPLATE_H
+#define CODESNIPTEMPLATE_H
+
+#include <QtCore/QString>
+#include <QtCore/QList>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+
+/**
+ *   A code snippet split once into literal text and type system variables.
+ *
+ *   A variable is a '%' followed either by an identifier ("%CPPSELF",
+ *   "%PYARG_1", "%ARG2_TYPE") or by a number ("%0", "%1"). Anything else
+ *   following a '%' is kept as literal text. The template of a type system
+ *   snippet is kept by the snippet itself (see CodeSnipAbstract::codeTemplate()),
+ *   text built while generating is scanned on the spot.
+ */
+class CodeSnipTemplate
+{
+public:
+    struct Token
+    {
+        enum Kind {
+            Literal,
+            Variable
+        };
+        Kind kind;
+        // The literal text, or the variable name without the leading '%'.
+        QString text;
+    };
+
+    explicit CodeSnipTemplate(const QString& code);
+
+    const QList<Token>& tokens() const { return m_tokens; }
+
+    /// Names of all the variables used in the snippet, without the leading '%'.
+    const QSet<QString>& variables() const { return m_variables; }
+
+    /// Returns true if the snippet uses the variable \p name (given without the leading '%').
+    bool uses(const QString& name) const { return m_variables.contains(name); }
+
+    /// Returns the number of times the variable \p name is used in the snippet.
+    int count(const QString& name) const;
+
+    /**
+     *   Returns the snippet with the variables found in \p values replaced
+     *   in a single pass. A value registered under "NAME." is preferred when
+     *   the variable is immediately followed by a dot, and replaces the dot
+     *   as well. Variables without a value are written back unchanged.
+     */
+    QString render(const QHash<QString, QString>& values) const;
+
+private:
+    QList<Token> m_tokens;
+    QSet<QString> m_variables;
+};
+
+#endif // CODESNIPTEMPLATE_H
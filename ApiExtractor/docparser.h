@@ -103,6 +103,7 @@ public:
 protected:
     QString getDocumentation(QXmlQuery& xquery, const QString& query,
                              const DocModificationList& mods) const;
+    QString applyDocModifications(const DocModificationList& mods, const QString& xml) const;
 
 private:
     QString m_packageName;
@@ -110,7 +111,6 @@ private:
     QString m_libSourceDir;
 
     QString execXQuery(QXmlQuery& xquery, const QString& query) const;
-    QString applyDocModifications(const DocModificationList& mods, const QString& xml) const;
 };
 
 #endif // DOCPARSER_H
@@ -25,7 +25,15 @@
 #include "abstractmetalang.h"
 #include "reporthandler.h"
 
-#include <QtXmlPatterns/QXmlQuery>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QStringList>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
 
 namespace
 {
@@ -44,6 +52,279 @@ QString getSectionKindAttr(const AbstractMetaFunction* func)
     }
 }
 
+struct DoxygenParam
+{
+    // Text nodes directly inside <type>, and the texts of its <ref> elements.
+    QStringList typeTexts;
+    QStringList refTexts;
+};
+
+struct DoxygenMember
+{
+    QString sectionKind;
+    QString kind;
+    QString name;
+    QString argsString;
+    QList<DoxygenParam> params;
+    QString description;
+    // The whole <memberdef> element, only kept for enums.
+    QString xml;
+};
+
+QDataStream& operator<<(QDataStream& out, const DoxygenParam& param)
+{
+    return out << param.typeTexts << param.refTexts;
+}
+
+QDataStream& operator>>(QDataStream& in, DoxygenParam& param)
+{
+    return in >> param.typeTexts >> param.refTexts;
+}
+
+QDataStream& operator<<(QDataStream& out, const DoxygenMember& member)
+{
+    return out << member.sectionKind << member.kind << member.name << member.argsString
+               << member.params << member.description << member.xml;
+}
+
+QDataStream& operator>>(QDataStream& in, DoxygenMember& member)
+{
+    return in >> member.sectionKind >> member.kind >> member.name >> member.argsString
+              >> member.params >> member.description >> member.xml;
+}
+
+/**
+ *  Descriptions of a Doxygen compound XML file, read in a single streaming pass.
+ *  Members are indexed by name, and overloads are told apart with the same
+ *  section kind and parameter criteria the XPath queries used to apply.
+ */
+class DoxygenIndex
+{
+public:
+    bool read(const QString& fileName, const QString& cacheDir);
+
+    QString description() const
+    {
+        return m_description;
+    }
+
+    QList<DoxygenMember> members(const QString& name) const
+    {
+        return m_members.value(name);
+    }
+
+private:
+    QString m_description;
+    QHash<QString, QList<DoxygenMember> > m_members;
+
+    bool parse(const QString& fileName);
+    void readMember(QXmlStreamReader& reader, const QString& sectionKind);
+    bool load(const QString& cacheFile, const QFileInfo& source, const QByteArray& sourceHash);
+    void save(const QString& cacheFile, const QFileInfo& source, const QByteArray& sourceHash) const;
+};
+
+// Bump whenever the layout of the cached indexes changes.
+static const quint32 DOXYGEN_INDEX_MAGIC = 0x53444f58; // "SDOX"
+static const quint32 DOXYGEN_INDEX_VERSION = 2;
+
+// Serializes the element at the current position of the reader, leaving it at its end element.
+static QString readElement(QXmlStreamReader& reader)
+{
+    QString xml;
+    QXmlStreamWriter writer(&xml);
+    writer.writeCurrentToken(reader);
+    int depth = 1;
+    while (depth > 0 && !reader.atEnd()) {
+        reader.readNext();
+        if (reader.isStartElement())
+            ++depth;
+        else if (reader.isEndElement())
+            --depth;
+        writer.writeCurrentToken(reader);
+    }
+    return xml;
+}
+
+// Modification times have a resolution of a second on many file systems, too coarse to
+// notice a regenerated file, so the cached indexes are stamped with the contents' hash.
+static QByteArray contentHash(const QString& fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    while (!file.atEnd())
+        hash.addData(file.read(64 * 1024));
+    return hash.result();
+}
+
+bool DoxygenIndex::read(const QString& fileName, const QString& cacheDir)
+{
+    if (cacheDir.isEmpty())
+        return parse(fileName);
+
+    QFileInfo source(fileName);
+    // Files with the same name may come from different documentation directories.
+    QString cacheFile = cacheDir + '/' + QString::number(qHash(source.absoluteFilePath()), 16)
+                        + '-' + source.fileName() + ".index";
+    QByteArray sourceHash = contentHash(fileName);
+    if (sourceHash.isEmpty())
+        return false;
+    if (load(cacheFile, source, sourceHash))
+        return true;
+    if (!parse(fileName))
+        return false;
+    save(cacheFile, source, sourceHash);
+    return true;
+}
+
+bool DoxygenIndex::parse(const QString& fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    // Only /doxygen/compounddef/detaileddescription and the members under
+    // /doxygen/compounddef/sectiondef/memberdef are indexed.
+    QXmlStreamReader reader(&file);
+    QStringList path;
+    QString sectionKind;
+    while (!reader.atEnd()) {
+        QXmlStreamReader::TokenType token = reader.readNext();
+        if (token == QXmlStreamReader::EndElement) {
+            path.removeLast();
+            continue;
+        }
+        if (token != QXmlStreamReader::StartElement)
+            continue;
+
+        QString name = reader.name().toString();
+        bool inCompound = path.size() >= 2 && path[0] == QLatin1String("doxygen")
+                          && path[1] == QLatin1String("compounddef");
+        if (inCompound && path.size() == 2 && name == QLatin1String("detaileddescription")) {
+            m_description += readElement(reader);
+            continue;
+        }
+        if (inCompound && path.size() == 3 && path[2] == QLatin1String("sectiondef")
+            && name == QLatin1String("memberdef")) {
+            readMember(reader, sectionKind);
+            continue;
+        }
+        if (inCompound && path.size() == 2 && name == QLatin1String("sectiondef"))
+            sectionKind = reader.attributes().value(QLatin1String("kind")).toString();
+        path << name;
+    }
+
+    if (reader.hasError()) {
+        ReportHandler::warning("Error reading doxygen file " + fileName
+                               + ": " + reader.errorString());
+        return false;
+    }
+    return true;
+}
+
+void DoxygenIndex::readMember(QXmlStreamReader& reader, const QString& sectionKind)
+{
+    DoxygenMember member;
+    member.sectionKind = sectionKind;
+    member.kind = reader.attributes().value(QLatin1String("kind")).toString();
+
+    QString xml;
+    QXmlStreamWriter writer(&xml);
+    QXmlStreamWriter descriptionWriter(&member.description);
+    writer.writeCurrentToken(reader);
+
+    // Element path relative to the <memberdef>.
+    QStringList path;
+    bool previousWasText = false;
+    while (!reader.atEnd()) {
+        QXmlStreamReader::TokenType token = reader.readNext();
+        writer.writeCurrentToken(reader);
+        if (token == QXmlStreamReader::EndElement && path.isEmpty())
+            break;
+
+        bool inDescription = path.value(0) == QLatin1String("detaileddescription")
+                             || (token == QXmlStreamReader::StartElement && path.isEmpty()
+                                 && reader.name() == QLatin1String("detaileddescription"));
+        if (inDescription)
+            descriptionWriter.writeCurrentToken(reader);
+
+        if (token == QXmlStreamReader::StartElement) {
+            path << reader.name().toString();
+            if (path.size() == 1 && path[0] == QLatin1String("param"))
+                member.params << DoxygenParam();
+        } else if (token == QXmlStreamReader::EndElement) {
+            path.removeLast();
+        } else if (token == QXmlStreamReader::Characters) {
+            QString text = reader.text().toString();
+            if (path.size() == 1 && path[0] == QLatin1String("name")) {
+                member.name += text;
+            } else if (path.size() == 1 && path[0] == QLatin1String("argsstring")) {
+                member.argsString += text;
+            } else if (path.size() >= 2 && path[0] == QLatin1String("param") && path[1] == QLatin1String("type")) {
+                // Adjacent character tokens belong to the same text node.
+                QStringList* texts = 0;
+                if (path.size() == 2)
+                    texts = &member.params.last().typeTexts;
+                else if (path.size() == 3 && path[2] == QLatin1String("ref"))
+                    texts = &member.params.last().refTexts;
+                if (texts) {
+                    if (previousWasText && !texts->isEmpty())
+                        texts->last() += text;
+                    else
+                        *texts << text;
+                }
+            }
+        }
+        previousWasText = token == QXmlStreamReader::Characters;
+    }
+
+    if (member.kind == QLatin1String("enum"))
+        member.xml = xml;
+    m_members[member.name] << member;
+}
+
+bool DoxygenIndex::load(const QString& cacheFile, const QFileInfo& source, const QByteArray& sourceHash)
+{
+    QFile file(cacheFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    quint32 magic, version;
+    qint64 size;
+    QByteArray hash;
+    in >> magic >> version;
+    if (magic != DOXYGEN_INDEX_MAGIC || version != DOXYGEN_INDEX_VERSION)
+        return false;
+    in.setVersion(QDataStream::Qt_4_5);
+    in >> size >> hash;
+    if (size != source.size() || hash != sourceHash)
+        return false;
+    in >> m_description >> m_members;
+    if (in.status() != QDataStream::Ok) {
+        m_description.clear();
+        m_members.clear();
+        return false;
+    }
+    return true;
+}
+
+void DoxygenIndex::save(const QString& cacheFile, const QFileInfo& source, const QByteArray& sourceHash) const
+{
+    QDir().mkpath(QFileInfo(cacheFile).absolutePath());
+    QFile file(cacheFile);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        ReportHandler::warning("Can't write doxygen index cache " + cacheFile);
+        return;
+    }
+
+    QDataStream out(&file);
+    out << DOXYGEN_INDEX_MAGIC << DOXYGEN_INDEX_VERSION;
+    out.setVersion(QDataStream::Qt_4_5);
+    out << qint64(source.size()) << sourceHash << m_description << m_members;
+}
+
 }
 
 Documentation DoxygenParser::retrieveModuleDocumentation()
@@ -66,7 +347,6 @@ void DoxygenParser::fillDocumentation(AbstractMetaClass* metaClass)
 
     const char* prefixes[] = { "class", "struct", "namespace" };
     const int numPrefixes = sizeof(prefixes) / sizeof(const char*);
-    bool isProperty = false;
 
     QString doxyFilePath;
     for (int i = 0; i < numPrefixes; ++i) {
@@ -83,12 +363,12 @@ void DoxygenParser::fillDocumentation(AbstractMetaClass* metaClass)
                                + doxyFileSuffix);
         return;
     }
-    QXmlQuery xquery;
-    xquery.setFocus(QUrl(doxyFilePath));
+    DoxygenIndex index;
+    index.read(doxyFilePath, m_cacheDir);
 
     // Get class documentation
-    QString classDoc = getDocumentation(xquery, "/doxygen/compounddef/detaileddescription",
-                                        metaClass->typeEntry()->docModifications());
+    QString classDoc = applyDocModifications(metaClass->typeEntry()->docModifications(),
+                                             index.description());
     if (classDoc.isEmpty()) {
         ReportHandler::warning("Can't find documentation for class \""
                                + metaClass->name() + "\".");
@@ -101,45 +381,48 @@ void DoxygenParser::fillDocumentation(AbstractMetaClass* metaClass)
         if (!func || func->isPrivate())
             continue;
 
-        QString query = "/doxygen/compounddef/sectiondef";
+        QString doc;
         // properties
         if (func->isPropertyReader() || func->isPropertyWriter()
             || func->isPropertyResetter()) {
-            query += "[@kind=\"property\"]/memberdef/name[text()=\""
-                     + func->propertySpec()->name() + "\"]";
-            isProperty = true;
+            // Only the description of the first property with that name is used.
+            foreach (const DoxygenMember& member, index.members(func->propertySpec()->name())) {
+                if (member.sectionKind == QLatin1String("property")) {
+                    doc = member.description;
+                    break;
+                }
+            }
         } else { // normal methods
-            QString kind = getSectionKindAttr(func);
-            query += "[@kind=\"" + kind + "-func\"]/memberdef/name[text()=\""
-                     + func->originalName() + "\"]";
-
-            if (func->arguments().isEmpty()) {
-                QString args = func->isConstant() ? "() const " : "()";
-                query += "/../argsstring[text()=\"" + args + "\"]";
-            } else {
-                int i = 1;
-                foreach (AbstractMetaArgument* arg, func->arguments()) {
-                    QString type;
-                    if (!arg->type()->isPrimitive()) {
-                        query += "/../param[" + QString::number(i) + "]/type/ref[text()=\""
-                                 + arg->type()->name() + "\"]/../..";
-                    } else {
-                        query += "/../param[" + QString::number(i) + "]/type[text()=\""
-                                 + arg->type()->name() + "\"]/..";
+            QString kind = getSectionKindAttr(func) + QLatin1String("-func");
+            QString args = func->isConstant() ? "() const " : "()";
+            foreach (const DoxygenMember& member, index.members(func->originalName())) {
+                if (member.sectionKind != kind)
+                    continue;
+
+                bool matches = true;
+                if (func->arguments().isEmpty()) {
+                    matches = member.argsString == args;
+                } else {
+                    int i = 0;
+                    foreach (AbstractMetaArgument* arg, func->arguments()) {
+                        if (i >= member.params.size()) {
+                            matches = false;
+                            break;
+                        }
+                        const DoxygenParam& param = member.params[i];
+                        const QStringList& texts = arg->type()->isPrimitive() ? param.typeTexts : param.refTexts;
+                        if (!texts.contains(arg->type()->name())) {
+                            matches = false;
+                            break;
+                        }
+                        ++i;
                     }
-                    ++i;
                 }
+                if (matches)
+                    doc += member.description;
             }
         }
-        if (!isProperty) {
-            query += "/../detaileddescription";
-        } else {
-            query = "(" + query;
-            query += "/../detaileddescription)[1]";
-        }
-        QString doc = getDocumentation(xquery, query, DocModificationList());
         func->setDocumentation(doc);
-        isProperty = false;
     }
 
     //Fields
@@ -148,17 +431,20 @@ void DoxygenParser::fillDocumentation(AbstractMetaClass* metaClass)
         if (field->isPrivate())
             return;
 
-        QString query = "/doxygen/compounddef/sectiondef/memberdef/name[text()=\""
-                        + field->name() + "\"]/../detaileddescription";
-        QString doc = getDocumentation(xquery, query, DocModificationList());
+        QString doc;
+        foreach (const DoxygenMember& member, index.members(field->name()))
+            doc += member.description;
         field->setDocumentation(doc);
     }
 
     //Enums
     AbstractMetaEnumList enums = metaClass->enums();
     foreach (AbstractMetaEnum *meta_enum, enums) {
-        QString query = "/doxygen/compounddef/sectiondef/memberdef[@kind=\"enum\"]/name[text()=\"" + meta_enum->name() + "\"]/..";
-        QString doc = getDocumentation(xquery, query, DocModificationList());
+        QString doc;
+        foreach (const DoxygenMember& member, index.members(meta_enum->name())) {
+            if (member.kind == QLatin1String("enum"))
+                doc += member.xml;
+        }
         meta_enum->setDocumentation(doc);
     }
 
@@ -175,11 +461,9 @@ Documentation DoxygenParser::retrieveModuleDocumentation(const QString& name){
         return Documentation();
     }
 
-    QXmlQuery xquery;
-    xquery.setFocus(QUrl(sourceFile));
+    DoxygenIndex index;
+    index.read(sourceFile, m_cacheDir);
 
     // Module documentation
-    QString query = "/doxygen/compounddef/detaileddescription";
-    return Documentation(getDocumentation(xquery, query, DocModificationList()));
+    return Documentation(index.description());
 }
-
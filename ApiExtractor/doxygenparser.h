@@ -33,6 +33,24 @@ public:
     virtual void fillDocumentation(AbstractMetaClass *metaClass);
     virtual Documentation retrieveModuleDocumentation();
     virtual Documentation retrieveModuleDocumentation(const QString& name);
+
+    /**
+     *   Sets the directory where the indexes built from the Doxygen XML files
+     *   are stored, so later runs can skip parsing the files that didn't change.
+     *   No cache is used when the directory is empty, which is the default.
+     */
+    void setCacheDirectory(const QString& dir)
+    {
+        m_cacheDir = dir;
+    }
+
+    QString cacheDirectory() const
+    {
+        return m_cacheDir;
+    }
+
+private:
+    QString m_cacheDir;
 };
 
 #endif // DOXYGENPARSER_H
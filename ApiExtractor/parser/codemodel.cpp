@@ -533,6 +533,54 @@ FunctionDefinitionList _ScopeModelItem::findFunctionDefinitions(const QString &n
     return _M_functionDefinitions.values(name);
 }
 
+void _ScopeModelItem::mergeScope(const _ScopeModelItem *other)
+{
+    // Headers shared by several translation units are seen once per unit,
+    // the first declaration found wins.
+    QHash<QString, ClassModelItem>::const_iterator cit = other->_M_classes.constBegin();
+    for (; cit != other->_M_classes.constEnd(); ++cit) {
+        if (!_M_classes.contains(cit.key()))
+            _M_classes.insert(cit.key(), cit.value());
+    }
+
+    foreach (EnumModelItem item, other->_M_enums) {
+        if (!_M_enums.contains(item->name()))
+            addEnum(item);
+    }
+
+    foreach (TypeAliasModelItem item, other->_M_typeAliases) {
+        if (!_M_typeAliases.contains(item->name()))
+            addTypeAlias(item);
+    }
+
+    foreach (VariableModelItem item, other->_M_variables) {
+        if (!_M_variables.contains(item->name()))
+            addVariable(item);
+    }
+
+    foreach (FunctionModelItem item, other->_M_functions) {
+        if (!declaredFunction(item))
+            addFunction(item);
+    }
+
+    foreach (FunctionDefinitionModelItem item, other->_M_functionDefinitions) {
+        bool found = false;
+        foreach (FunctionDefinitionModelItem def, findFunctionDefinitions(item->name())) {
+            if (def->isSimilar(model_static_cast<FunctionModelItem>(item))) {
+                found = true;
+                break;
+            }
+        }
+        if (!found)
+            addFunctionDefinition(item);
+    }
+
+    foreach (const QString &enumsDeclaration, other->_M_enumsDeclarations) {
+        if (!_M_enumsDeclarations.contains(enumsDeclaration))
+            addEnumsDeclaration(enumsDeclaration);
+    }
+}
+
 // ---------------------------------------------------------------------------
 NamespaceList _NamespaceModelItem::namespaces() const
 {
@@ -555,6 +603,21 @@ NamespaceModelItem _NamespaceModelItem::findNamespace(const QString &name) const
     return _M_namespaces.value(name);
 }
 
+void _NamespaceModelItem::merge(NamespaceModelItem other)
+{
+    if (!other || other.data() == this)
+        return;
+
+    mergeScope(other.data());
+
+    foreach (NamespaceModelItem ns, other->_M_namespaces) {
+        if (NamespaceModelItem existing = findNamespace(ns->name()))
+            existing->merge(ns);
+        else
+            addNamespace(ns);
+    }
+}
+
 // ---------------------------------------------------------------------------
 TypeInfo _ArgumentModelItem::type() const
 {
@@ -389,6 +389,8 @@ protected:
     _ScopeModelItem(CodeModel *model, int kind = __node_kind)
             : _CodeModelItem(model, kind) {}
 
+    void mergeScope(const _ScopeModelItem *other);
+
 private:
     QHash<QString, ClassModelItem> _M_classes;
     QHash<QString, EnumModelItem> _M_enums;
@@ -463,6 +465,13 @@ public:
 
     NamespaceModelItem findNamespace(const QString &name) const;
 
+    /**
+     *   Adds to this namespace every item of \p other that it doesn't
+     *   declare yet; namespaces present in both are merged recursively.
+     *   Used to join translation units that were parsed separately.
+     */
+    void merge(NamespaceModelItem other);
+
     inline QHash<QString, NamespaceModelItem> namespaceMap() const
     {
         return _M_namespaces;
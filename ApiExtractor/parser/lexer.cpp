@@ -27,9 +27,128 @@
 #include "tokens.h"
 #include "control.h"
 
+#include <QtCore/QMutex>
 #include <cctype>
 #include <iostream>
 
+#if defined(__AVX2__)
+#  include <immintrin.h>
+#  define LEXER_USE_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define LEXER_USE_SSE2
+#endif
+#if defined(_MSC_VER) && (defined(LEXER_USE_SSE2) || defined(LEXER_USE_AVX2))
+#  include <intrin.h>
+#endif
+
+/*
+ * Vectorized fast paths used to skip runs of blanks and identifier characters.
+ * They only recognize plain ASCII and stop at the first byte they are not sure
+ * about, the scalar loops in the scanners take over from there, so the result
+ * is exactly the same as scanning byte by byte. Blocks are never read past the
+ * end of the buffer.
+ */
+#if defined(LEXER_USE_SSE2) || defined(LEXER_USE_AVX2)
+static inline unsigned int firstSetBit(unsigned int mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+#if defined(LEXER_USE_AVX2)
+// ' ', '\t', '\v', '\f' and '\r', newlines are left to scan_newline.
+static inline unsigned int blankMask(__m256i chars)
+{
+    const __m256i controls = _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('\t' - 1)),
+                                              _mm256_cmpgt_epi8(_mm256_set1_epi8('\r' + 1), chars));
+    const __m256i newlines = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\n'));
+    const __m256i spaces = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(' '));
+    return _mm256_movemask_epi8(_mm256_or_si256(_mm256_andnot_si256(newlines, controls), spaces));
+}
+
+// [A-Za-z0-9_]
+static inline unsigned int identifierMask(__m256i chars)
+{
+    const __m256i lower = _mm256_or_si256(chars, _mm256_set1_epi8(0x20));
+    const __m256i letters = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+                                             _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), lower));
+    const __m256i digits = _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('0' - 1)),
+                                            _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), chars));
+    const __m256i underscores = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('_'));
+    return _mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(letters, digits), underscores));
+}
+#endif
+
+#if defined(LEXER_USE_SSE2)
+static inline unsigned int blankMask(__m128i chars)
+{
+    const __m128i controls = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('\t' - 1)),
+                                           _mm_cmplt_epi8(chars, _mm_set1_epi8('\r' + 1)));
+    const __m128i newlines = _mm_cmpeq_epi8(chars, _mm_set1_epi8('\n'));
+    const __m128i spaces = _mm_cmpeq_epi8(chars, _mm_set1_epi8(' '));
+    return _mm_movemask_epi8(_mm_or_si128(_mm_andnot_si128(newlines, controls), spaces));
+}
+
+static inline unsigned int identifierMask(__m128i chars)
+{
+    const __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+    const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                          _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+    const __m128i digits = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+                                         _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+    const __m128i underscores = _mm_cmpeq_epi8(chars, _mm_set1_epi8('_'));
+    return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(letters, digits), underscores));
+}
+#endif
+
+static inline const unsigned char *skipBlanks(const unsigned char *cursor, const unsigned char *end)
+{
+#if defined(LEXER_USE_AVX2)
+    for (; end - cursor >= 32; cursor += 32) {
+        unsigned int mask = ~blankMask(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(cursor)));
+        if (mask)
+            return cursor + firstSetBit(mask);
+    }
+#endif
+#if defined(LEXER_USE_SSE2)
+    for (; end - cursor >= 16; cursor += 16) {
+        unsigned int mask = ~blankMask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor))) & 0xffff;
+        if (mask)
+            return cursor + firstSetBit(mask);
+    }
+#endif
+    Q_UNUSED(end);
+    return cursor;
+}
+
+static inline const unsigned char *skipIdentifierChars(const unsigned char *cursor, const unsigned char *end)
+{
+#if defined(LEXER_USE_AVX2)
+    for (; end - cursor >= 32; cursor += 32) {
+        unsigned int mask = ~identifierMask(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(cursor)));
+        if (mask)
+            return cursor + firstSetBit(mask);
+    }
+#endif
+#if defined(LEXER_USE_SSE2)
+    for (; end - cursor >= 16; cursor += 16) {
+        unsigned int mask = ~identifierMask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor))) & 0xffff;
+        if (mask)
+            return cursor + firstSetBit(mask);
+    }
+#endif
+    Q_UNUSED(end);
+    return cursor;
+}
+
 scan_fun_ptr Lexer::s_scan_keyword_table[] = {
     &Lexer::scanKeyword0, &Lexer::scanKeyword0,
     &Lexer::scanKeyword2, &Lexer::scanKeyword3,
@@ -98,14 +217,23 @@ void LocationManager::positionAt(std::size_t offset, int *line, int *column,
 }
 
 scan_fun_ptr Lexer::s_scan_table[256];
-bool Lexer::s_initialized = false;
+QAtomicInt Lexer::s_initialized(0);
+static QMutex scanTableMutex;
 
 void Lexer::tokenize(const char *contents, std::size_t size)
 {
-    if (!s_initialized)
-        initialize_scan_table();
+    // Translation units can be lexed concurrently, only one of them fills the table.
+    // The acquire read pairs with the release store done once the table is complete.
+    if (!s_initialized.fetchAndAddAcquire(0)) {
+        QMutexLocker locker(&scanTableMutex);
+        if (!s_initialized.fetchAndAddAcquire(0))
+            initialize_scan_table();
+    }
 
-    token_stream.resize(1024);
+    // Preprocessed headers average well over eight bytes per token and over
+    // thirty per line, sizing the tables from the input spares most of the
+    // reallocations (and copies) done while they grow.
+    token_stream.resize(qMax<std::size_t>(1024, size / 8));
     token_stream[0].kind = Token_EOF;
     token_stream[0].text = contents;
 
@@ -115,7 +243,7 @@ void Lexer::tokenize(const char *contents, std::size_t size)
     begin_buffer = (const unsigned char *) contents;
     end_buffer = cursor + size;
 
-    location_table.resize(1024);
+    location_table.resize(qMax<std::size_t>(1024, size / 32));
     location_table[0] = 0;
     location_table.current_line = 1;
 
@@ -161,8 +289,6 @@ void Lexer::reportError(const QString& msg)
 
 void Lexer::initialize_scan_table()
 {
-    s_initialized = true;
-
     for (int i = 0; i < 256; ++i) {
         if (isspace(i))
             s_scan_table[i] = &Lexer::scan_white_spaces;
@@ -208,6 +334,8 @@ void Lexer::initialize_scan_table()
     s_scan_table[int('~')] = &Lexer::scan_tilde;
 
     s_scan_table[0] = &Lexer::scan_EOF;
+
+    s_initialized.fetchAndStoreRelease(1);
 }
 
 void Lexer::scan_preprocessor()
@@ -285,11 +413,14 @@ void Lexer::scan_newline()
 
 void Lexer::scan_white_spaces()
 {
-    while (isspace(*cursor)) {
+    for (;;) {
+        cursor = skipBlanks(cursor, end_buffer);
         if (*cursor == '\n')
             scan_newline();
-        else
+        else if (isspace(*cursor))
             ++cursor;
+        else
+            break;
     }
 }
 
@@ -314,7 +445,7 @@ void Lexer::scan_identifier_or_literal()
 
 void Lexer::scan_identifier_or_keyword()
 {
-    const unsigned char *skip = cursor;
+    const unsigned char *skip = skipIdentifierChars(cursor, end_buffer);
     while (isalnum(*skip) || *skip == '_')
         ++skip;
 
@@ -29,6 +29,7 @@
 #include "symbol.h"
 
 #include <QtCore/QString>
+#include <QtCore/QAtomicInt>
 #include <cstdlib>
 #include <cassert>
 
@@ -282,7 +283,7 @@ private:
 
     static scan_fun_ptr s_scan_table[];
     static scan_fun_ptr s_scan_keyword_table[];
-    static bool s_initialized;
+    static QAtomicInt s_initialized;
 };
 
 #endif // LEXER_H
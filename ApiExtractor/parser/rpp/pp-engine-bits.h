@@ -59,15 +59,37 @@ inline bool pp::is_absolute(std::string const &filename) const
 #endif
 }
 
+inline std::string pp::canonical_path(std::string const &__filename) const
+{
+#if defined (PP_OS_WIN)
+    char __buffer[_MAX_PATH];
+    if (_fullpath(__buffer, __filename.c_str(), _MAX_PATH))
+        return __buffer;
+#else
+    char __buffer[PATH_MAX];
+    if (realpath(__filename.c_str(), __buffer))
+        return __buffer;
+#endif
+    return __filename;
+}
+
 template <typename _OutputIterator>
 void pp::file(std::string const &filename, _OutputIterator __result)
 {
     FILE *fp = std::fopen(filename.c_str(), "rb");
     if (fp != 0) {
         std::string was = env.current_file;
+        std::string was_canonical = _M_current_canonical_file;
         env.current_file = filename;
+        _M_current_canonical_file = canonical_path(filename);
         file(fp, __result);
+
+        // a file wrapped in a single include guard is not read again while the guard is defined
+        if (!_M_last_guard.empty())
+            _M_include_guards[_M_current_canonical_file] = _M_last_guard;
+
         env.current_file = was;
+        _M_current_canonical_file = was_canonical;
     }
     //else
     //std::cerr << "** WARNING file ``" << filename << " not found!" << std::endl;
@@ -78,28 +100,35 @@ void pp::file(FILE *fp, _OutputIterator __result)
 {
     assert(fp != 0);
 
-#if defined (HAVE_MMAP)
     struct stat st;
-    fstat(FILENO(fp), &st);
-    std::size_t size = st.st_size;
-    char *buffer = 0;
-    buffer = (char *) ::mmap(0, size, PROT_READ, MAP_SHARED, FILENO(fp), 0);
-    fclose(fp);
-    if (!buffer || buffer == (char*) - 1)
+    if (fstat(FILENO(fp), &st) != 0) {
+        fclose(fp);
         return;
-    this->operator()(buffer, buffer + size, __result);
-    ::munmap(buffer, size);
-#else
-    std::string buffer;
-    while (!feof(fp)) {
-        char tmp[1024];
-        int read = (int) fread(tmp, sizeof(char), 1023, fp);
-        tmp[read] = '\0';
-        buffer += tmp;
     }
+    std::size_t size = st.st_size;
+    pp_reserve_output(__result, size);
+
+#if defined (HAVE_MMAP)
+    // The scanners may peek one character past the end of the buffer, which
+    // is only safe to do on a mapping when the file doesn't fill its last page.
+    static const std::size_t page_size = (std::size_t) sysconf(_SC_PAGESIZE);
+    if (size != 0 && size % page_size != 0) {
+        char *buffer = (char *) ::mmap(0, size, PROT_READ, MAP_PRIVATE, FILENO(fp), 0);
+        if (buffer != (char *) MAP_FAILED) {
+            fclose(fp);
+            this->operator()(buffer, buffer + size, __result);
+            ::munmap(buffer, size);
+            return;
+        }
+    }
+#endif
+
+    std::string buffer;
+    buffer.resize(size);
+    if (size != 0)
+        buffer.resize(fread(&buffer[0], sizeof(char), size, fp));
     fclose(fp);
     this->operator()(buffer.c_str(), buffer.c_str() + buffer.size(), __result);
-#endif
 }
 
 template <typename _InputIterator>
@@ -150,6 +179,21 @@ bool pp::find_header_protection(_InputIterator __first, _InputIterator __last, s
     return false;
 }
 
+template <typename _InputIterator>
+bool pp::only_blanks_and_comments(_InputIterator __first, _InputIterator __last)
+{
+    while (__first != __last) {
+        if (pp_isspace(*__first))
+            ++__first;
+        else if (_PP_internal::comment_p(__first, __last))
+            __first = skip_comment_or_divop(__first, __last);
+        else
+            return false;
+    }
+
+    return true;
+}
+
 inline pp::PP_DIRECTIVE_TYPE pp::find_directive(char const *__directive, std::size_t __size) const
 {
     switch (__size) {
@@ -235,8 +279,48 @@ inline bool pp::file_exists(std::string const &__filename) const
 #endif
 }
 
-inline FILE *pp::find_include_file(std::string const &__input_filename, std::string *__filepath,
-                                   INCLUDE_POLICY __include_policy, bool __skip_current_path) const
+inline bool pp::find_include_file(std::string const &__input_filename, std::string *__filepath,
+                                  INCLUDE_POLICY __include_policy, bool __skip_current_path) const
+{
+    assert(__filepath != 0);
+
+    // the include paths may have been changed through include_paths_inserter()
+    if (_M_include_cache_paths != include_paths.size()) {
+        _M_include_cache.clear();
+        _M_include_cache_paths = include_paths.size();
+    }
+
+    // the lookup only depends on the directory of the including file
+    std::string __key;
+    if (! env.current_file.empty())
+        _PP_internal::extract_file_path(env.current_file, &__key);
+    __key += char('0' + __include_policy);
+    __key += __skip_current_path ? '1' : '0';
+    __key += __input_filename;
+
+    std::map<std::string, std::string>::const_iterator it = _M_include_cache.find(__key);
+    if (it != _M_include_cache.end()) {
+        __filepath->assign(it->second);
+        return !it->second.empty();
+    }
+
+    bool __found = lookup_include_file(__input_filename, __filepath, __include_policy, __skip_current_path);
+    _M_include_cache[__key] = __found ? *__filepath : std::string();
+    return __found;
+}
+
+inline bool pp::include_already_seen(std::string const &__canonical) const
+{
+    if (_M_pragma_once_files.find(__canonical) != _M_pragma_once_files.end())
+        return true;
+
+    std::map<std::string, std::string>::const_iterator it = _M_include_guards.find(__canonical);
+    return it != _M_include_guards.end()
+           && env.resolve(it->second.c_str(), it->second.size()) != 0;
+}
+
+inline bool pp::lookup_include_file(std::string const &__input_filename, std::string *__filepath,
+                                    INCLUDE_POLICY __include_policy, bool __skip_current_path) const
 {
     assert(__filepath != 0);
     assert(! __input_filename.empty());
@@ -244,7 +328,7 @@ inline FILE *pp::find_include_file(std::string const &__input_filename, std::str
     __filepath->assign(__input_filename);
 
     if (is_absolute(*__filepath))
-        return std::fopen(__filepath->c_str(), "r");
+        return file_exists(*__filepath) && !file_isdir(*__filepath);
 
     if (! env.current_file.empty())
         _PP_internal::extract_file_path(env.current_file, __filepath);
@@ -255,7 +339,7 @@ inline FILE *pp::find_include_file(std::string const &__input_filename, std::str
 
         if (file_exists(__tmp) && !file_isdir(__tmp)) {
             __filepath->append(__input_filename);
-            return std::fopen(__filepath->c_str(), "r");
+            return true;
         }
     }
 
@@ -279,7 +363,7 @@ inline FILE *pp::find_include_file(std::string const &__input_filename, std::str
         __filepath->append(__input_filename);
 
         if (file_exists(*__filepath) && !file_isdir(*__filepath))
-            return std::fopen(__filepath->c_str(), "r");
+            return true;
 
 #ifdef Q_OS_MAC
         // try in Framework path on Mac, if there is a path in front
@@ -293,12 +377,12 @@ inline FILE *pp::find_include_file(std::string const &__input_filename, std::str
             std::cerr << *__filepath << "\n";
 
             if (file_exists(*__filepath) && !file_isdir(*__filepath))
-                return fopen(__filepath->c_str(), "r");
+                return true;
         }
 #endif // Q_OS_MAC
     }
 
-    return 0;
+    return false;
 }
 
 template <typename _InputIterator, typename _OutputIterator>
@@ -333,6 +417,11 @@ _InputIterator pp::handle_directive(char const *__directive, std::size_t __size,
             return handle_undef(__first, __last);
         break;
 
+    case PP_PRAGMA:
+        if (! skipping())
+            return handle_pragma(__first, __last);
+        break;
+
     case PP_ELIF:
         return handle_elif(__first, __last);
 
@@ -400,24 +489,21 @@ _InputIterator pp::handle_include(bool __skip_current_path, _InputIterator __fir
 #endif
 
     std::string filepath;
-    FILE *fp = find_include_file(filename, &filepath, quote == '>' ? INCLUDE_GLOBAL : INCLUDE_LOCAL, __skip_current_path);
+    bool found = find_include_file(filename, &filepath, quote == '>' ? INCLUDE_GLOBAL : INCLUDE_LOCAL, __skip_current_path);
 
 #if defined (PP_HOOK_ON_FILE_INCLUDED)
-    PP_HOOK_ON_FILE_INCLUDED(env.current_file, fp ? filepath : filename, fp);
+    PP_HOOK_ON_FILE_INCLUDED(env.current_file, found ? filepath : filename);
 #endif
 
-    if (fp != 0) {
-        std::string old_file = env.current_file;
-        env.current_file = filepath;
+    if (found && !include_already_seen(canonical_path(filepath))) {
         int __saved_lines = env.current_line;
 
         env.current_line = 1;
         //output_line (env.current_file, 1, __result);
 
-        file(fp, __result);
+        file(filepath, __result);
 
-        // restore the file name and the line position
-        env.current_file = old_file;
+        // restore the line position
         env.current_line = __saved_lines;
 
         // sync the buffer
@@ -434,16 +520,16 @@ _InputIterator pp::handle_include(bool __skip_current_path, _InputIterator __fir
 template <typename _InputIterator, typename _OutputIterator>
 void pp::operator()(_InputIterator __first, _InputIterator __last, _OutputIterator __result)
 {
-#ifndef PP_NO_SMART_HEADER_PROTECTION
+    // Track whether the buffer is entirely wrapped in "#ifndef X ... #endif",
+    // in which case it can be skipped on later inclusions while X is defined.
     std::string __prot;
-    __prot.reserve(255);
-    pp_fast_string __tmp(__prot.c_str(), __prot.size());
+    int __prot_level = -1;
+    bool __prot_opened = false;
+    bool __protected = false;
 
-    if (find_header_protection(__first, __last, &__prot)
-        && env.resolve(&__tmp) != 0) {
-        // std::cerr << "** DEBUG found header protection:" << __prot << std::endl;
-        return;
-    }
+#ifndef PP_NO_SMART_HEADER_PROTECTION
+    if (find_header_protection(__first, __last, &__prot))
+        __prot_level = iflevel;
 #endif
 
     env.current_line = 1;
@@ -479,6 +565,19 @@ void pp::operator()(_InputIterator __first, _InputIterator __last, _OutputIterat
                 env.current_line = was;
                 _PP_internal::output_line(env.current_file, env.current_line, __result);
             }
+
+            if (__prot_level >= 0) {
+                if (iflevel > __prot_level) {
+                    // an #else or #elif of the guard means it doesn't cover everything
+                    if (__prot_opened && iflevel == __prot_level + 1 && __size == 4
+                        && (!strcmp(__buffer, "else") || !strcmp(__buffer, "elif")))
+                        __prot_level = -1;
+                    __prot_opened = true;
+                } else if (__prot_opened) {
+                    __protected = only_blanks_and_comments(__first, __last);
+                    __prot_level = -1;
+                }
+            }
         } else if (*__first == '\n') {
             // ### compress the line
             *__result++ = *__first++;
@@ -494,10 +593,15 @@ void pp::operator()(_InputIterator __first, _InputIterator __last, _OutputIterat
                 _PP_internal::output_line(env.current_file, env.current_line, __result);
         }
     }
+
+    if (__protected)
+        _M_last_guard.swap(__prot);
+    else
+        _M_last_guard.clear();
 }
 
 inline pp::pp(pp_environment &__env):
-        env(__env), expand(env)
+        env(__env), expand(env), _M_include_cache_paths(0)
 {
     iflevel = 0;
     _M_skipping[iflevel] = 0;
@@ -541,6 +645,18 @@ inline void pp::push_include_path(std::string const &__path)
         include_paths.push_back(__path);
 }
 
+template <typename _InputIterator>
+_InputIterator pp::handle_pragma(_InputIterator __first, _InputIterator __last)
+{
+    _InputIterator end_id = skip_identifier(__first, __last);
+
+    if (end_id - __first == 4 && std::equal(__first, end_id, "once")
+        && !_M_current_canonical_file.empty())
+        _M_pragma_once_files.insert(_M_current_canonical_file);
+
+    return __first;
+}
+
 template <typename _InputIterator>
 _InputIterator pp::handle_define(_InputIterator __first, _InputIterator __last)
 {
@@ -552,7 +668,7 @@ _InputIterator pp::handle_define(_InputIterator __first, _InputIterator __last)
 
     __first = skip_blanks(__first, __last);
     _InputIterator end_macro_name = skip_identifier(__first, __last);
-    pp_fast_string const *macro_name = pp_symbol::get(__first, end_macro_name);
+    pp_fast_string const *macro_name = pp_symbol::intern(__first, end_macro_name);
     __first = end_macro_name;
 
     if (__first != __last && *__first == '(') {
@@ -562,7 +678,7 @@ _InputIterator pp::handle_define(_InputIterator __first, _InputIterator __last)
         __first = skip_blanks(++__first, __last);  // skip '('
         _InputIterator arg_end = skip_identifier(__first, __last);
         if (__first != arg_end)
-            macro.formals.push_back(pp_symbol::get(__first, arg_end));
+            macro.formals.push_back(pp_symbol::intern(__first, arg_end));
 
         __first = skip_blanks(arg_end, __last);
 
@@ -577,7 +693,7 @@ _InputIterator pp::handle_define(_InputIterator __first, _InputIterator __last)
 
             arg_end = skip_identifier(__first, __last);
             if (__first != arg_end)
-                macro.formals.push_back(pp_symbol::get(__first, arg_end));
+                macro.formals.push_back(pp_symbol::intern(__first, arg_end));
 
             __first = skip_blanks(arg_end, __last);
 
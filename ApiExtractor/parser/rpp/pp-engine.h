@@ -25,6 +25,8 @@
 #ifndef PP_ENGINE_H
 #define PP_ENGINE_H
 
+#include <map>
+#include <set>
 #include <string>
 #include <vector>
 #include "pp-scanner.h"
@@ -110,6 +112,18 @@ class pp
     std::vector<std::string> include_paths;
     std::string _M_current_text;
 
+    // canonical path of the file being preprocessed
+    std::string _M_current_canonical_file;
+    // guard macro of the last buffer preprocessed, empty unless the guard spans the whole buffer
+    std::string _M_last_guard;
+    // canonical file path -> macro guarding the whole file
+    std::map<std::string, std::string> _M_include_guards;
+    // canonical paths of the files marked with #pragma once
+    std::set<std::string> _M_pragma_once_files;
+    // include lookup -> resolved file path, empty when the lookup failed
+    mutable std::map<std::string, std::string> _M_include_cache;
+    mutable std::size_t _M_include_cache_paths;
+
     enum { MAX_LEVEL = 512 };
     int _M_skipping[MAX_LEVEL];
     int _M_true_test[MAX_LEVEL];
@@ -187,8 +201,12 @@ public:
 private:
     inline bool file_isdir(std::string const &__filename) const;
     inline bool file_exists(std::string const &__filename) const;
-    FILE *find_include_file(std::string const &__filename, std::string *__filepath,
-                            INCLUDE_POLICY __include_policy, bool __skip_current_path = false) const;
+    bool find_include_file(std::string const &__filename, std::string *__filepath,
+                           INCLUDE_POLICY __include_policy, bool __skip_current_path = false) const;
+    bool lookup_include_file(std::string const &__filename, std::string *__filepath,
+                             INCLUDE_POLICY __include_policy, bool __skip_current_path) const;
+    inline std::string canonical_path(std::string const &__filename) const;
+    inline bool include_already_seen(std::string const &__canonical) const;
 
     inline int skipping() const;
     bool test_if_level();
@@ -201,6 +219,9 @@ private:
     template <typename _InputIterator>
     bool find_header_protection(_InputIterator __first, _InputIterator __last, std::string *__prot);
 
+    template <typename _InputIterator>
+    bool only_blanks_and_comments(_InputIterator __first, _InputIterator __last);
+
     template <typename _InputIterator>
     _InputIterator skip(_InputIterator __first, _InputIterator __last);
 
@@ -251,6 +272,9 @@ private:
     template <typename _InputIterator>
     _InputIterator handle_define(_InputIterator __first, _InputIterator __last);
 
+    template <typename _InputIterator>
+    _InputIterator handle_pragma(_InputIterator __first, _InputIterator __last);
+
     template <typename _InputIterator>
     _InputIterator handle_if(_InputIterator __first, _InputIterator __last);
 
@@ -29,6 +29,7 @@
 #include <string>
 #include <cstring>
 #include "pp-macro.h"
+#include "parser/rxx_allocator.h"
 
 namespace rpp
 {
@@ -41,15 +42,14 @@ public:
 public:
     pp_environment():
             current_line(0),
-            _M_hash_size(4093) {
-        _M_base = (pp_macro **) memset(new pp_macro* [_M_hash_size], 0, _M_hash_size * sizeof(pp_macro*));
+            _M_slots(4096),
+            _M_slot_count(0) {
     }
 
     ~pp_environment() {
+        // the macros live in _M_macro_allocator, only their members need to be released
         for (std::size_t i = 0; i < _M_macros.size(); ++i)
-            delete _M_macros [i];
-
-        delete [] _M_base;
+            _M_macros [i]->~pp_macro();
     }
 
     const_iterator first_macro() const {
@@ -60,16 +60,19 @@ public:
     }
 
     inline void bind(pp_fast_string const *__name, pp_macro const &__macro) {
-        std::size_t h = hash_code(*__name) % _M_hash_size;
-        pp_macro *m = new pp_macro(__macro);
+        pp_macro *m = new (_M_macro_allocator.allocate(1)) pp_macro(__macro);
         m->name = __name;
-        m->next = _M_base [h];
-        m->hash_code = h;
-        _M_base [h] = m;
-
         _M_macros.push_back(m);
 
-        if (_M_macros.size() == _M_hash_size)
+        // a redefinition replaces the previous macro
+        _Slot &__slot = find_slot(*__name);
+        if (!__slot.macro) {
+            __slot.hash = __name->hash_code();
+            ++_M_slot_count;
+        }
+        __slot.macro = m;
+
+        if (_M_slot_count * 2 > _M_slots.size())
             rehash();
     }
 
@@ -84,13 +87,8 @@ public:
     }
 
     inline pp_macro *resolve(pp_fast_string const *__name) const {
-        std::size_t h = hash_code(*__name) % _M_hash_size;
-        pp_macro *it = _M_base [h];
-
-        while (it && it->name && it->hash_code == h && (*it->name != *__name || it->hidden))
-            it = it->next;
-
-        return it;
+        pp_macro *m = const_cast<pp_environment *>(this)->find_slot(*__name).macro;
+        return m && !m->hidden ? m : 0;
     }
 
     inline pp_macro *resolve(char const *__data, std::size_t __size) const {
@@ -102,34 +100,53 @@ public:
     int current_line;
 
 private:
-    inline std::size_t hash_code(pp_fast_string const &s) const {
-        std::size_t hash_value = 0;
-
-        for (std::size_t i = 0; i < s.size(); ++i)
-            hash_value = (hash_value << 5) - hash_value + s.at(i);
-
-        return hash_value;
+    // The hash code is kept next to the macro so that probing compares
+    // names only when the hashes match, without touching the macros.
+    struct _Slot {
+        std::size_t hash;
+        pp_macro *macro;
+
+        _Slot(): hash(0), macro(0) {}
+    };
+
+    // Linear probing, returns the slot holding __name or the empty slot where it belongs.
+    inline _Slot &find_slot(pp_fast_string const &__name) {
+        std::size_t const __hash = __name.hash_code();
+        std::size_t const __mask = _M_slots.size() - 1;
+        std::size_t __index = __hash & __mask;
+
+        while (_M_slots [__index].macro) {
+            _Slot &__slot = _M_slots [__index];
+            if (__slot.hash == __hash && *__slot.macro->name == __name)
+                return __slot;
+            __index = (__index + 1) & __mask;
+        }
+        return _M_slots [__index];
     }
 
     void rehash() {
-        delete[] _M_base;
-
-        _M_hash_size <<= 1;
-
-        _M_base = (pp_macro **) memset(new pp_macro* [_M_hash_size], 0, _M_hash_size * sizeof(pp_macro*));
-        for (std::size_t index = 0; index < _M_macros.size(); ++index) {
-            pp_macro *elt = _M_macros [index];
-            std::size_t h = hash_code(*elt->name) % _M_hash_size;
-            elt->next = _M_base [h];
-            elt->hash_code = h;
-            _M_base [h] = elt;
+        std::vector<_Slot> __old(_M_slots.size() << 1);
+        __old.swap(_M_slots);
+
+        std::size_t const __mask = _M_slots.size() - 1;
+        for (std::size_t i = 0; i < __old.size(); ++i) {
+            if (!__old [i].macro)
+                continue;
+            std::size_t __index = __old [i].hash & __mask;
+            while (_M_slots [__index].macro)
+                __index = (__index + 1) & __mask;
+            _M_slots [__index] = __old [i];
         }
     }
 
 private:
     std::vector<pp_macro*> _M_macros;
-    pp_macro **_M_base;
-    std::size_t _M_hash_size;
+    std::vector<_Slot> _M_slots;
+    std::size_t _M_slot_count;
+    rxx_allocator<pp_macro> _M_macro_allocator;
+
+    pp_environment(pp_environment const &);
+    void operator = (pp_environment const &);
 };
 
 } // namespace rpp
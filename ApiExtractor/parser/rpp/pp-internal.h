@@ -97,14 +97,7 @@ struct _Equal_to_string: public std::binary_function<bool, pp_fast_string const
 
 struct _Hash_string: public std::unary_function<std::size_t, pp_fast_string const *> {
     inline std::size_t operator()(pp_fast_string const *__s) const {
-        char const *__ptr = __s->begin();
-        std::size_t __size = __s->size();
-        std::size_t __h = 0;
-
-        for (std::size_t i = 0; i < __size; ++i)
-            __h = (__h << 5) - __h + __ptr [i];
-
-        return __h;
+        return __s->hash_code();
     }
 };
 
@@ -25,6 +25,7 @@
 #ifndef PP_ITERATOR_H
 #define PP_ITERATOR_H
 
+#include <algorithm>
 #include <iterator>
 
 namespace rpp
@@ -68,6 +69,13 @@ public:
         return *this;
     }
 
+    // makes room for __size more characters, e.g. the contents of a file about to be read
+    inline void reserve(std::size_t __size) {
+        std::size_t __needed = _M_result.size() + __size;
+        if (_M_result.capacity() < __needed)
+            _M_result.reserve(std::max(__needed, _M_result.capacity() << 1));
+    }
+
     inline pp_output_iterator &operator=(typename _Container::const_reference __v) {
         if (_M_result.capacity() == _M_result.size())
             _M_result.reserve(_M_result.capacity() << 2);
@@ -87,6 +95,17 @@ public:
     }
 };
 
+template <typename _OutputIterator>
+inline void pp_reserve_output(_OutputIterator &, std::size_t)
+{
+}
+
+template <typename _Container>
+inline void pp_reserve_output(pp_output_iterator<_Container> &__result, std::size_t __size)
+{
+    __result.reserve(__size);
+}
+
 } // namespace rpp
 
 #endif // PP_ITERATOR_H
@@ -50,6 +50,9 @@ class pp_macro_expander
     pp_skip_blanks skip_blanks;
     pp_skip_whitespaces skip_whitespaces;
 
+    // The identifier following "defined" must not be expanded.
+    bool hide_next;
+
     std::string const *resolve_formal(pp_fast_string const *__name) {
         assert(__name != 0);
 
@@ -81,7 +84,7 @@ public: // attributes
 
 public:
     pp_macro_expander(pp_environment &__env, pp_frame *__frame = 0):
-            env(__env), frame(__frame), lines(0), generated_lines(0) {}
+            env(__env), frame(__frame), hide_next(false), lines(0), generated_lines(0) {}
 
     template <typename _InputIterator, typename _OutputIterator>
     _InputIterator operator()(_InputIterator __first, _InputIterator __last, _OutputIterator __result) {
@@ -201,8 +204,6 @@ public:
                     continue;
                 }
 
-                static bool hide_next = false; // ### remove me
-
                 pp_macro *macro = env.resolve(name_buffer, name_size);
                 if (! macro || macro->hidden || hide_next) {
                     hide_next = ! strcmp(name_buffer, "defined");
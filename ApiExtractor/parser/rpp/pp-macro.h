@@ -50,8 +50,6 @@ struct pp_macro {
     };
 
     int lines;
-    pp_macro *next;
-    std::size_t hash_code;
 
     inline pp_macro():
 #if defined (PP_WITH_MACRO_POSITION)
@@ -60,9 +58,7 @@ struct pp_macro {
             name(0),
             definition(0),
             state(0),
-            lines(0),
-            next(0),
-            hash_code(0) {}
+            lines(0) {}
 };
 
 } // namespace rpp
@@ -36,16 +36,17 @@ class pp_string
 
     _CharT const *_M_begin;
     std::size_t _M_size;
+    mutable std::size_t _M_hash; // 0 until hash_code() is first called
 
 public:
     inline pp_string():
-            _M_begin(0), _M_size(0) {}
+            _M_begin(0), _M_size(0), _M_hash(0) {}
 
     explicit pp_string(std::string const &__s):
-            _M_begin(__s.c_str()), _M_size(__s.size()) {}
+            _M_begin(__s.c_str()), _M_size(__s.size()), _M_hash(0) {}
 
     inline pp_string(_CharT const *__begin, std::size_t __size):
-            _M_begin(__begin), _M_size(__size) {}
+            _M_begin(__begin), _M_size(__size), _M_hash(0) {}
 
     inline _CharT const *begin() const {
         return _M_begin;
@@ -62,6 +63,27 @@ public:
         return _M_size;
     }
 
+    // FNV-1a, computed once per string and cached afterwards.
+    inline std::size_t hash_code() const {
+        if (!_M_hash) {
+            std::size_t __h = 2166136261u;
+            for (std::size_t __i = 0; __i < _M_size; ++__i)
+                __h = (__h ^ (unsigned char) _M_begin[__i]) * 16777619u;
+            _M_hash = __h ? __h : 1;
+        }
+        return _M_hash;
+    }
+
+    inline bool equals(pp_string const &__other) const {
+        if (this == &__other)
+            return true;
+        if (_M_size != __other._M_size)
+            return false;
+        if (_M_hash && __other._M_hash && _M_hash != __other._M_hash)
+            return false;
+        return !traits_type::compare(_M_begin, __other._M_begin, _M_size);
+    }
+
     inline int compare(pp_string const &__other) const {
         size_type const __size = this->size();
         size_type const __osize = __other.size();
@@ -75,11 +97,11 @@ public:
     }
 
     inline bool operator == (pp_string const &__other) const {
-        return compare(__other) == 0;
+        return equals(__other);
     }
 
     inline bool operator != (pp_string const &__other) const {
-        return compare(__other) != 0;
+        return !equals(__other);
     }
 
     inline bool operator < (pp_string const &__other) const {
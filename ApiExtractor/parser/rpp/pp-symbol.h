@@ -27,8 +27,10 @@
 
 #include <cassert>
 #include <iterator>
+#include <vector>
 #include "pp-fwd.h"
 #include "parser/rxx_allocator.h"
+#include <QtCore/QMutex>
 
 namespace rpp
 {
@@ -44,15 +46,27 @@ class pp_symbol
         static rxx_allocator<pp_fast_string>__ppfs_allocator;
         return __ppfs_allocator;
     }
+    // Translation units may be preprocessed on several threads at once,
+    // and they all share the symbol allocators above.
+    static QMutex &mutex_instance()
+    {
+        static QMutex __mutex;
+        return __mutex;
+    }
 
-public:
-    static int &N() {
-        static int __N;
-        return __N;
+    // Open addressing table of the interned symbols, its size is a power of two.
+    static std::vector<pp_fast_string const *> &intern_table_instance()
+    {
+        static std::vector<pp_fast_string const *> __table(1024, static_cast<pp_fast_string const *>(0));
+        return __table;
+    }
+    static std::size_t &intern_count()
+    {
+        static std::size_t __count;
+        return __count;
     }
 
-    static pp_fast_string const *get(char const *__data, std::size_t __size) {
-        ++N();
+    static pp_fast_string const *allocate(char const *__data, std::size_t __size) {
         char *data = allocator_instance().allocate(__size + 1);
         memcpy(data, __data, __size);
         data[__size] = '\0';
@@ -61,8 +75,37 @@ public:
         return new(where) pp_fast_string(data, __size);
     }
 
+    static void grow_intern_table() {
+        std::vector<pp_fast_string const *> &__table = intern_table_instance();
+        std::vector<pp_fast_string const *> __old(__table.size() * 2, static_cast<pp_fast_string const *>(0));
+        __old.swap(__table);
+
+        std::size_t const __mask = __table.size() - 1;
+        for (std::size_t __i = 0; __i < __old.size(); ++__i) {
+            if (!__old[__i])
+                continue;
+            std::size_t __slot = __old[__i]->hash_code() & __mask;
+            while (__table[__slot])
+                __slot = (__slot + 1) & __mask;
+            __table[__slot] = __old[__i];
+        }
+    }
+
+public:
+    static int &N() {
+        static int __N;
+        return __N;
+    }
+
+    static pp_fast_string const *get(char const *__data, std::size_t __size) {
+        QMutexLocker __lock(&mutex_instance());
+        ++N();
+        return allocate(__data, __size);
+    }
+
     template <typename _InputIterator>
     static pp_fast_string const *get(_InputIterator __first, _InputIterator __last) {
+        QMutexLocker __lock(&mutex_instance());
         ++N();
         std::ptrdiff_t __size;
 #if defined(__SUNPRO_CC)
@@ -83,6 +126,51 @@ public:
     static pp_fast_string const *get(std::string const &__s) {
         return get(__s.c_str(), __s.size());
     }
+
+    /**
+     * Returns the unique symbol spelled as the given characters, equal names
+     * share a single string (and its cached hash code) however many times
+     * they are interned. Used for macro names and formal parameters.
+     */
+    static pp_fast_string const *intern(char const *__data, std::size_t __size) {
+        pp_fast_string const __key(__data, __size);
+
+        QMutexLocker __lock(&mutex_instance());
+        std::vector<pp_fast_string const *> &__table = intern_table_instance();
+        std::size_t const __mask = __table.size() - 1;
+        std::size_t __slot = __key.hash_code() & __mask;
+        while (pp_fast_string const *__symbol = __table[__slot]) {
+            if (*__symbol == __key)
+                return __symbol;
+            __slot = (__slot + 1) & __mask;
+        }
+
+        ++N();
+        pp_fast_string const *__symbol = allocate(__data, __size);
+        __symbol->hash_code();
+        __table[__slot] = __symbol;
+
+        // keep the load factor under one half
+        if (++intern_count() * 2 > __table.size())
+            grow_intern_table();
+
+        return __symbol;
+    }
+
+    template <typename _InputIterator>
+    static pp_fast_string const *intern(_InputIterator __first, _InputIterator __last) {
+        std::ptrdiff_t __size;
+#if defined(__SUNPRO_CC)
+        std::distance(__first, __last, __size);
+#else
+        __size = std::distance(__first, __last);
+#endif
+        assert(__size >= 0 && __size < 512);
+
+        char __buffer[512];
+        std::copy(__first, __last, __buffer);
+        return intern(__buffer, __size);
+    }
 };
 
 } // namespace rpp
@@ -30,6 +30,10 @@
 #  define PP_OS_WIN
 #endif
 
+#if !defined (PP_OS_WIN) && !defined (HAVE_MMAP) && !defined (PP_NO_MMAP)
+#  define HAVE_MMAP
+#endif
+
 #include <set>
 #include <map>
 #include <vector>
@@ -39,11 +43,14 @@
 #include <cassert>
 #include <cctype>
 #include <cstdio>
+#include <cstdlib>
+#include <climits>
 
 #include <fcntl.h>
 
 #ifdef HAVE_MMAP
 #  include <sys/mman.h>
+#  include <unistd.h>
 #endif
 
 #include <sys/stat.h>
@@ -28,9 +28,9 @@
 #include <cstdio>
 
 // register callback for include hooks
-static void includeFileHook(const std::string &, const std::string &, FILE *);
+static void includeFileHook(const std::string &, const std::string &);
 
-#define PP_HOOK_ON_FILE_INCLUDED(A, B, C) includeFileHook(A, B, C)
+#define PP_HOOK_ON_FILE_INCLUDED(A, B) includeFileHook(A, B)
 #include "pp.h"
 
 using namespace rpp;
@@ -52,7 +52,7 @@ public:
 
 QHash<QString, QStringList> includedFiles;
 
-void includeFileHook(const std::string &fileName, const std::string &filePath, FILE *)
+void includeFileHook(const std::string &fileName, const std::string &filePath)
 {
     includedFiles[QString::fromStdString(fileName)].append(QString::fromStdString(filePath));
 }
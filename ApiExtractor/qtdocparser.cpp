@@ -23,8 +23,143 @@
 
 #include "qtdocparser.h"
 #include "reporthandler.h"
-#include <QtXmlPatterns/QXmlQuery>
-#include <QUrl>
+#include <QFile>
+#include <QHash>
+#include <QStringList>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+namespace
+{
+
+/**
+ *  Descriptions found in a WebXML file, read in a single streaming pass and indexed
+ *  by the class, namespace, page or member they describe. Looking up the documentation
+ *  of each function is then a hash lookup instead of a query scanning the whole file.
+ *  An index is owned by the fillDocumentation() call that reads it, so independent
+ *  classes can have their documentation filled concurrently.
+ */
+class WebXmlIndex
+{
+public:
+    bool read(const QString& fileName);
+
+    QString description(const QString& key) const
+    {
+        return m_descriptions.value(key);
+    }
+
+    static QString scopeKey(const QString& type, const QString& name)
+    {
+        return type + ':' + name;
+    }
+
+    static QString memberKey(const QString& scope, const QString& type, const QString& name)
+    {
+        return scope + '/' + type + ':' + name;
+    }
+
+    static QString functionKey(const QString& scope, const QString& name,
+                               const QStringList& parameterTypes, bool isConst)
+    {
+        return memberKey(scope, QLatin1String("function"), name)
+               + '(' + parameterTypes.join(QLatin1String("|")) + ')'
+               + (isConst ? QLatin1String(" const") : QLatin1String(""));
+    }
+
+private:
+    QHash<QString, QString> m_descriptions;
+};
+
+// Serializes the element at the current position of the reader, leaving it at its end element.
+static QString readElement(QXmlStreamReader& reader)
+{
+    QString xml;
+    QXmlStreamWriter writer(&xml);
+    writer.writeCurrentToken(reader);
+    int depth = 1;
+    while (depth > 0 && !reader.atEnd()) {
+        reader.readNext();
+        if (reader.isStartElement())
+            ++depth;
+        else if (reader.isEndElement())
+            --depth;
+        writer.writeCurrentToken(reader);
+    }
+    return xml;
+}
+
+bool WebXmlIndex::read(const QString& fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    // Elements are indexed from the /WebXML/document/<scope>/<member> path,
+    // matching the descriptions previously selected with XPath queries.
+    QXmlStreamReader reader(&file);
+    QStringList path;
+    QString scope;
+    QString member;
+    QString functionName;
+    QStringList parameterTypes;
+    bool isConst = false;
+    QString functionDescription;
+
+    while (!reader.atEnd()) {
+        QXmlStreamReader::TokenType token = reader.readNext();
+        if (token == QXmlStreamReader::EndElement) {
+            if (path.size() == 4 && !scope.isEmpty() && path.last() == QLatin1String("function"))
+                m_descriptions[functionKey(scope, functionName, parameterTypes, isConst)] += functionDescription;
+            path.removeLast();
+            continue;
+        }
+        if (token != QXmlStreamReader::StartElement)
+            continue;
+
+        QString name = reader.name().toString();
+        if (name == QLatin1String("description") && !scope.isEmpty()
+            && (path.size() == 3 || path.size() == 4)) {
+            QString xml = readElement(reader);
+            if (path.size() == 3)
+                m_descriptions[scope] += xml;
+            else if (path.last() == QLatin1String("function"))
+                functionDescription += xml;
+            else
+                m_descriptions[member] += xml;
+            continue;
+        }
+
+        path << name;
+        QXmlStreamAttributes attributes = reader.attributes();
+        if (path.size() == 3) {
+            if (path[0] == QLatin1String("WebXML") && path[1] == QLatin1String("document"))
+                scope = scopeKey(name, attributes.value(QLatin1String("name")).toString());
+            else
+                scope.clear();
+        } else if (path.size() == 4) {
+            if (name == QLatin1String("function")) {
+                functionName = attributes.value(QLatin1String("name")).toString();
+                isConst = attributes.value(QLatin1String("const")) == QLatin1String("true");
+                parameterTypes.clear();
+                functionDescription.clear();
+            } else {
+                member = memberKey(scope, name, attributes.value(QLatin1String("name")).toString());
+            }
+        } else if (path.size() == 5 && name == QLatin1String("parameter") && path[3] == QLatin1String("function")) {
+            parameterTypes << attributes.value(QLatin1String("left")).toString();
+        }
+    }
+
+    if (reader.hasError()) {
+        ReportHandler::warning("Error reading documentation file " + fileName
+                               + ": " + reader.errorString());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
 
 Documentation QtDocParser::retrieveModuleDocumentation()
 {
@@ -56,14 +191,14 @@ void QtDocParser::fillDocumentation(AbstractMetaClass* metaClass)
         return;
     }
 
-    QXmlQuery xquery;
-    xquery.setFocus(QUrl(sourceFile));
+    WebXmlIndex index;
+    index.read(sourceFile);
 
     QString className = metaClass->name();
 
     // Class/Namespace documentation
     QString type = metaClass->isNamespace() ? QLatin1String("namespace") : QLatin1String("class");
-    QString query = "/WebXML/document/" + type + "[@name=\"" + className + "\"]/description";
+    QString classKey = WebXmlIndex::scopeKey(type, className);
 
     DocModificationList signedModifs, classModifs;
     foreach (DocModification docModif, metaClass->typeEntry()->docModifications()) {
@@ -73,7 +208,7 @@ void QtDocParser::fillDocumentation(AbstractMetaClass* metaClass)
             signedModifs.append(docModif);
     }
 
-    Documentation doc(getDocumentation(xquery, query, classModifs));
+    Documentation doc(applyDocModifications(classModifs, index.description(classKey)));
     metaClass->setDocumentation(doc);
 
 
@@ -83,18 +218,12 @@ void QtDocParser::fillDocumentation(AbstractMetaClass* metaClass)
         if (!func || func->isPrivate())
             continue;
 
-        QString query = "/WebXML/document/" + type + "[@" + "name" + "=\"" + className + "\"]";
+        QString key;
         // properties
         if (func->isPropertyReader() || func->isPropertyWriter() || func->isPropertyResetter()) {
-            query += "/property[@name=\"" + func->propertySpec()->name() + "\"]";
+            key = WebXmlIndex::memberKey(classKey, QLatin1String("property"), func->propertySpec()->name());
         } else { // normal methods
-            QString isConst = func->isConstant() ? "true" : "false";
-            query += "/function[@name=\"" + func->originalName()
-                     + "\" and count(parameter)="
-                     + QString::number(func->arguments().count())
-                     + " and @const=\"" + isConst + "\"]";
-
-            int i = 1;
+            QStringList parameterTypes;
             foreach (AbstractMetaArgument* arg, func->arguments()) {
                 QString type = arg->type()->name();
 
@@ -108,17 +237,16 @@ void QtDocParser::fillDocumentation(AbstractMetaClass* metaClass)
                     for (int j = 0, max = arg->type()->indirections(); j < max; ++j)
                         type += '*';
                 }
-                query += "/parameter[" + QString::number(i) + "][@left=\"" + type + "\"]/..";
-                ++i;
+                parameterTypes << type;
             }
+            key = WebXmlIndex::functionKey(classKey, func->originalName(), parameterTypes, func->isConstant());
         }
-        query += "/description";
         DocModificationList funcModifs;
         foreach (DocModification funcModif, signedModifs) {
             if (funcModif.signature() == func->minimalSignature())
                 funcModifs.append(funcModif);
         }
-        doc.setValue(getDocumentation(xquery, query, funcModifs));
+        doc.setValue(applyDocModifications(funcModifs, index.description(key)));
         func->setDocumentation(doc);
     }
 #if 0
@@ -136,10 +264,8 @@ void QtDocParser::fillDocumentation(AbstractMetaClass* metaClass)
     // Enums
     AbstractMetaEnumList enums = metaClass->enums();
     foreach (AbstractMetaEnum *meta_enum, enums) {
-        QString query = "/WebXML/document/" + type + "[@" + "name" + "=\""
-                        + className + "\"]/enum[@name=\""
-                        + meta_enum->name() + "\"]/description";
-        doc.setValue(getDocumentation(xquery, query, DocModificationList()));
+        QString key = WebXmlIndex::memberKey(classKey, QLatin1String("enum"), meta_enum->name());
+        doc.setValue(index.description(key));
         meta_enum->setDocumentation(doc);
     }
 }
@@ -158,10 +284,9 @@ Documentation QtDocParser::retrieveModuleDocumentation(const QString& name)
         return Documentation();
     }
 
-    QXmlQuery xquery;
-    xquery.setFocus(QUrl(sourceFile));
+    WebXmlIndex index;
+    index.read(sourceFile);
 
     // Module documentation
-    QString query = "/WebXML/document/page[@name=\"" + moduleName + "\"]/description";
-    return Documentation(getDocumentation(xquery, query, DocModificationList()));
+    return Documentation(index.description(WebXmlIndex::scopeKey(QLatin1String("page"), moduleName)));
 }
@@ -24,6 +24,8 @@
 #include "reporthandler.h"
 #include "typesystem.h"
 #include "typedatabase.h"
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
 #include <QtCore/QSet>
 #include <cstring>
 #include <cstdarg>
@@ -51,6 +53,8 @@ static QString m_progressBuffer;
 static int m_step_size = 0;
 static int m_step = -1;
 static int m_step_warning = 0;
+// Generators may report from several threads.
+static QMutex m_mutex;
 
 static void printProgress()
 {
@@ -117,6 +121,7 @@ void ReportHandler::warning(const QString &text)
     if (m_silent)
         return;
 
+    QMutexLocker locker(&m_mutex);
 // Context is useless!
 //     QString warningText = QString("\r" COLOR_YELLOW "WARNING(%1)" COLOR_END " :: %2").arg(m_context).arg(text);
     TypeDatabase *db = TypeDatabase::instance();
@@ -166,6 +171,7 @@ void ReportHandler::debug(DebugLevel level, const QString &text)
         return;
 
     if (level <= m_debugLevel) {
+        QMutexLocker locker(&m_mutex);
         std::printf("\r" COLOR_GREEN "DEBUG" COLOR_END " :: %-70s\n", qPrintable(text));
         printProgress();
     }
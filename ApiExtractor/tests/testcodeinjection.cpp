@@ -26,6 +26,7 @@
 #include <QDir>
 #include <QtTest/QTest>
 #include "testutil.h"
+#include <codesniptemplate.h>
 
 void TestCodeInjections::testReadFileUtf8()
 {
@@ -92,6 +93,38 @@ void TestCodeInjections::testInjectWithInvalidApiVersion()
 }
 
 
+void TestCodeInjections::testCodeTemplateSharedByCopies()
+{
+    const char* cppCode ="struct A {};";
+    const char* xmlCode = "\
+    <typesystem package='Foo'> \
+        <value-type name='A'> \
+            <inject-code class='target'>%CPPSELF.method(%1);</inject-code>\
+        </value-type>\
+    </typesystem>";
+
+    TestUtil t(cppCode, xmlCode);
+    AbstractMetaClassList classes = t.builder()->classes();
+    AbstractMetaClass* classA = classes.findClass("A");
+    QCOMPARE(classA->typeEntry()->codeSnips().count(), 1);
+
+    CodeSnip snip = classA->typeEntry()->codeSnips().first();
+    const CodeSnipTemplate& tmpl = snip.codeTemplate();
+    QVERIFY(tmpl.uses("CPPSELF"));
+    QVERIFY(tmpl.uses("1"));
+    QCOMPARE(tmpl.variables().size(), 2);
+
+    // Copies made afterwards, and the snippet kept by the type entry, share the parsed code.
+    CodeSnip copy = snip;
+    QCOMPARE(&copy.codeTemplate(), &tmpl);
+    QCOMPARE(&classA->typeEntry()->codeSnips().first().codeTemplate(), &tmpl);
+
+    // Changing the code of a copy gives it a template of its own.
+    copy.addCode(" %PYARG_0 = 0;");
+    QVERIFY(copy.codeTemplate().uses("PYARG_0"));
+    QVERIFY(!snip.codeTemplate().uses("PYARG_0"));
+    QCOMPARE(&snip.codeTemplate(), &tmpl);
+}
 
 QTEST_APPLESS_MAIN(TestCodeInjections)
 
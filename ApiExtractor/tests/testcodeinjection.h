@@ -35,6 +35,7 @@ private slots:
     void testReadFileUtf8();
     void testInjectWithValidApiVersion();
     void testInjectWithInvalidApiVersion();
+    void testCodeTemplateSharedByCopies();
 };
 
 #endif
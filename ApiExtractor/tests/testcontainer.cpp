@@ -94,6 +94,49 @@ void TestContainer::testListOfValueType()
     QVERIFY(templateInstanceType->isValue());
 }
 
+void TestContainer::testContainerView()
+{
+    const char* cppCode ="\
+    namespace std {\
+    template<class T>\
+    class list {};\
+    template<class K, class V>\
+    class map {};\
+    }\
+    class A {\
+    public:\
+        std::list<int> items();\
+        std::list<int> itemsView();\
+    };\
+    ";
+    const char* xmlCode = "\
+    <typesystem package='Foo'> \
+        <namespace-type name='std' generate='no' /> \
+        <primitive-type name='int'/> \
+        <container-type name='std::list' type='list' /> \
+        <container-type name='std::map' type='map' view='yes' /> \
+        <object-type name='A'> \
+            <modify-function signature='itemsView()'> \
+                <modify-argument index='return' view='yes'/> \
+            </modify-function> \
+        </object-type> \
+    </typesystem>";
+
+    TestUtil t(cppCode, xmlCode, false);
+    TypeDatabase* db = TypeDatabase::instance();
+    QVERIFY(!db->findContainerType("std::list")->returnsView());
+    QVERIFY(db->findContainerType("std::map")->returnsView());
+
+    AbstractMetaClass* classA = t.builder()->classes().findClass("A");
+    QVERIFY(classA);
+    const AbstractMetaFunction* items = classA->findFunction("items");
+    QVERIFY(items);
+    QVERIFY(!items->returnsContainerView());
+    const AbstractMetaFunction* itemsView = classA->findFunction("itemsView");
+    QVERIFY(itemsView);
+    QVERIFY(itemsView->returnsContainerView());
+}
+
 QTEST_APPLESS_MAIN(TestContainer)
 
 #include "testcontainer.moc"
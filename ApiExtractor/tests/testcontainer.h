@@ -31,6 +31,7 @@ class TestContainer : public QObject
 private slots:
     void testContainerType();
     void testListOfValueType();
+    void testContainerView();
 };
 
 #endif
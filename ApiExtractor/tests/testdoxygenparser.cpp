@@ -0,0 +1,147 @@
+/*
+* This file is part of the API Extractor project.
+*
+* Copyright (C) 2009 Nokia Corporation and/or its subsidiary(-ies).
+*
+* Contact: PySide team <contact@pyside.org>
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+* 02110-1301 USA
+*
+*/
+
+#include "testdoxygenparser.h"
+
+#include <QCoreApplication>
+#include <QtTest/QTest>
+#include "testutil.h"
+#include <doxygenparser.h>
+
+static const char* cppCode ="\
+class C {\
+public:\
+    enum Mode { Fast, Slow };\
+    void c();\
+    void c(int x);\
+    void c(const C& other);\
+};";
+
+static const char* xmlCode = "\
+<typesystem package=\"Foo\">\
+    <primitive-type name='int'/>\
+    <value-type name='C'>\
+        <enum-type name='Mode'/>\
+    </value-type>\
+</typesystem>";
+
+static void checkDocumentation(AbstractMetaClass* classC)
+{
+    QCOMPARE(classC->documentation().value(), QString("<detaileddescription>C</detaileddescription>"));
+
+    QStringList docs;
+    foreach (const AbstractMetaFunction* func, classC->queryFunctionsByName("c"))
+        docs << func->documentation().value();
+    docs.sort();
+    QCOMPARE(docs, QStringList() << "<detaileddescription>c()</detaileddescription>"
+                                 << "<detaileddescription>c(C)</detaileddescription>"
+                                 << "<detaileddescription>c(int)</detaileddescription>");
+
+    AbstractMetaEnum* metaEnum = classC->findEnum("Mode");
+    QVERIFY(metaEnum);
+    QVERIFY(metaEnum->documentation().value().contains("<detaileddescription>Mode</detaileddescription>"));
+}
+
+void TestDoxygenParser::testFunctionDocumentation()
+{
+    TestUtil t(cppCode, xmlCode);
+    AbstractMetaClass* classC = t.builder()->classes().findClass("C");
+    QVERIFY(classC);
+
+    DoxygenParser docParser;
+    docParser.setDocumentationDataDirectory(QDir::currentPath());
+    docParser.fillDocumentation(classC);
+    checkDocumentation(classC);
+}
+
+void TestDoxygenParser::testCachedIndex()
+{
+    QString cacheDir = QDir::currentPath() + "/doxygencache";
+    QDir dir(cacheDir);
+    foreach (QString fileName, dir.entryList(QDir::Files))
+        dir.remove(fileName);
+
+    for (int run = 0; run < 2; ++run) {
+        TestUtil t(cppCode, xmlCode);
+        AbstractMetaClass* classC = t.builder()->classes().findClass("C");
+        QVERIFY(classC);
+
+        DoxygenParser docParser;
+        docParser.setDocumentationDataDirectory(QDir::currentPath());
+        docParser.setCacheDirectory(cacheDir);
+        docParser.fillDocumentation(classC);
+        checkDocumentation(classC);
+        QCOMPARE(QDir(cacheDir).entryList(QDir::Files).count(), 1);
+    }
+}
+
+void TestDoxygenParser::testCachedIndexOfChangedFile()
+{
+    // A copy of the documentation, changed afterwards without changing its size,
+    // most likely within the same second.
+    QString dataDir = QDir::currentPath() + "/doxygenchanged";
+    QString cacheDir = dataDir + "/cache";
+    QDir().mkpath(cacheDir);
+    QDir dir(cacheDir);
+    foreach (QString fileName, dir.entryList(QDir::Files))
+        dir.remove(fileName);
+
+    QFile original(QDir::currentPath() + "/classC.xml");
+    QVERIFY(original.open(QIODevice::ReadOnly));
+    QByteArray contents = original.readAll();
+    QString copyName = dataDir + "/classC.xml";
+
+    for (int run = 0; run < 2; ++run) {
+        if (run == 1)
+            contents.replace("<detaileddescription>c(int)</detaileddescription>", "<detaileddescription>c(INT)</detaileddescription>");
+        QFile copy(copyName);
+        QVERIFY(copy.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        copy.write(contents);
+        copy.close();
+
+        TestUtil t(cppCode, xmlCode);
+        AbstractMetaClass* classC = t.builder()->classes().findClass("C");
+        QVERIFY(classC);
+
+        DoxygenParser docParser;
+        docParser.setDocumentationDataDirectory(dataDir);
+        docParser.setCacheDirectory(cacheDir);
+        docParser.fillDocumentation(classC);
+
+        QStringList docs;
+        foreach (const AbstractMetaFunction* func, classC->queryFunctionsByName("c"))
+            docs << func->documentation().value();
+        QCOMPARE(docs.contains("<detaileddescription>c(INT)</detaileddescription>"), run == 1);
+    }
+    QFile::remove(copyName);
+}
+
+// Like testmodifydocumentation, use QCoreApplication instead of QApplication.
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+    TestDoxygenParser tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "testdoxygenparser.moc"
@@ -0,0 +1,126 @@
+/*
+* This file is part of the API Extractor project.
+*
+* Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+*
+* Contact: PySide team <contact@pyside.org>
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+* 02110-1301 USA
+*
+*/
+
+#include "testlexer.h"
+#include <QtTest/QTest>
+#include "parser/control.h"
+#include "parser/lexer.h"
+#include "parser/tokens.h"
+
+class LexerFixture
+{
+public:
+    LexerFixture()
+        : location(tokenStream, locationTable, lineTable), lexer(location, &control) {}
+
+    void tokenize(const QByteArray& contents)
+    {
+        lexer.tokenize(contents.constData(), contents.size());
+    }
+
+    QByteArray tokenText(std::size_t index)
+    {
+        const Token& token = tokenStream[(int) index];
+        return QByteArray(token.text + token.position, (int) token.size);
+    }
+
+    Control control;
+    TokenStream tokenStream;
+    LocationTable locationTable;
+    LocationTable lineTable;
+    LocationManager location;
+    Lexer lexer;
+};
+
+// Identifiers and blank runs longer than a vector block, with mixed blank characters.
+static QByteArray createSource(int lines, QList<QByteArray>* identifiers = 0)
+{
+    static const char identifierChars[] = "aZ_9bY8cX7";
+    QByteArray contents;
+    for (int i = 0; i < lines; ++i) {
+        QByteArray identifier;
+        int length = i % 70 + 1;
+        for (int j = 0; j < length; ++j)
+            identifier += identifierChars[(i + j) % 10];
+        if (identifier.at(0) >= '0' && identifier.at(0) <= '9')
+            identifier.prepend('_');
+
+        contents += QByteArray(i % 37, ' ');
+        contents += "\t\r";
+        contents += identifier;
+        contents += QByteArray(i % 19, ' ');
+        contents += ";\n";
+
+        if (identifiers)
+            *identifiers << identifier;
+    }
+    return contents;
+}
+
+void TestLexer::testLongIdentifiersAndBlanks()
+{
+    QList<QByteArray> identifiers;
+    QByteArray contents = createSource(200, &identifiers);
+
+    LexerFixture fixture;
+    fixture.tokenize(contents);
+
+    std::size_t index = 1;
+    foreach (const QByteArray& identifier, identifiers) {
+        QCOMPARE(fixture.tokenStream.kind(index), int(Token_identifier));
+        QCOMPARE(fixture.tokenText(index), identifier);
+        ++index;
+        QCOMPARE(fixture.tokenStream.kind(index), int(';'));
+        ++index;
+    }
+    QCOMPARE(fixture.tokenStream.kind(index), int(Token_EOF));
+
+    int line, column;
+    fixture.locationTable.positionAt(fixture.tokenStream.position(index - 1), &line, &column);
+    QCOMPARE(line, identifiers.size());
+}
+
+void TestLexer::testIdentifierAtEndOfBuffer()
+{
+    QByteArray identifier("an_identifier_longer_than_thirty_two_characters");
+    LexerFixture fixture;
+    fixture.tokenize("  " + identifier);
+
+    QCOMPARE(fixture.tokenStream.kind(1), int(Token_identifier));
+    QCOMPARE(fixture.tokenText(1), identifier);
+    QCOMPARE(fixture.tokenStream.kind(2), int(Token_EOF));
+}
+
+void TestLexer::benchmarkTokenize()
+{
+    QByteArray contents = createSource(200000);
+
+    QBENCHMARK {
+        LexerFixture fixture;
+        fixture.tokenize(contents);
+    }
+}
+
+QTEST_APPLESS_MAIN(TestLexer)
+
+#include "testlexer.moc"
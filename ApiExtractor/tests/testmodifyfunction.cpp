@@ -239,6 +239,95 @@ void TestModifyFunction::testGlobalFunctionModification()
     QCOMPARE(arg->defaultValueExpression(), QString("A()"));
 }
 
+void TestModifyFunction::testModificationsFollowHierarchyChanges()
+{
+    const char* cppCode ="\
+    struct A {\
+        virtual void method(A* a);\
+    };\
+    struct B {\
+        virtual void method(A* a);\
+    };\
+    ";
+    const char* xmlCode = "\
+    <typesystem package='Foo'> \
+        <object-type name='A'> \
+        <modify-function signature='method(A*)'>\
+            <modify-argument index='1'>\
+                <define-ownership owner='c++' /> \
+            </modify-argument>\
+        </modify-function>\
+        </object-type>\
+        <object-type name='B' /> \
+    </typesystem>";
+    TestUtil t(cppCode, xmlCode, false);
+    AbstractMetaClassList classes = t.builder()->classes();
+    AbstractMetaClass* classA = classes.findClass("A");
+    AbstractMetaClass* classB = classes.findClass("B");
+    QVERIFY(classA);
+    QVERIFY(classB);
+    const AbstractMetaFunction* func = classB->findFunction("method");
+    QVERIFY(func);
+
+    // Fill the cache before the class hierarchy changes.
+    QVERIFY(func->modifications(classB).isEmpty());
+    QCOMPARE(func->ownership(classB, TypeSystem::TargetLangCode, 1), TypeSystem::InvalidOwnership);
+
+    // Modifications inherited from a new base class must not be hidden by the cache.
+    classB->setBaseClass(classA);
+    QCOMPARE(func->modifications(classB).size(), 1);
+    QCOMPARE(func->ownership(classB, TypeSystem::TargetLangCode, 1), TypeSystem::CppOwnership);
+    QVERIFY(func->disabledGarbageCollection(classB, 1));
+
+    classB->setBaseClass(0);
+    QVERIFY(func->modifications(classB).isEmpty());
+}
+
+void TestModifyFunction::testFrozenModificationCaches()
+{
+    const char* cppCode ="\
+    struct A {\
+        virtual void method(A* a);\
+    };\
+    struct B : A {\
+        virtual void method(A* a);\
+    };\
+    ";
+    const char* xmlCode = "\
+    <typesystem package='Foo'> \
+        <object-type name='A'> \
+        <modify-function signature='method(A*)'>\
+            <modify-argument index='1'>\
+                <define-ownership owner='c++' /> \
+            </modify-argument>\
+        </modify-function>\
+        </object-type>\
+        <object-type name='B' /> \
+    </typesystem>";
+    TestUtil t(cppCode, xmlCode, false);
+    AbstractMetaClassList classes = t.builder()->classes();
+    AbstractMetaClass* classA = classes.findClass("A");
+    AbstractMetaClass* classB = classes.findClass("B");
+    QVERIFY(classA);
+    QVERIFY(classB);
+    const AbstractMetaFunction* func = classB->findFunction("method");
+    QVERIFY(func);
+
+    func->fillModificationCache(classB);
+    AbstractMetaFunction::setModificationCachesFrozen(true);
+    QCOMPARE(func->modifications(classB).size(), 1);
+    QCOMPARE(func->ownership(classB, TypeSystem::TargetLangCode, 1), TypeSystem::CppOwnership);
+
+    // Entries missing from a frozen cache, or made stale, are computed again.
+    classB->setBaseClass(0);
+    QVERIFY(func->modifications(classB).isEmpty());
+    classB->setBaseClass(classA);
+    QCOMPARE(func->modifications(classB).size(), 1);
+    AbstractMetaFunction::setModificationCachesFrozen(false);
+
+    QCOMPARE(func->modifications(classB).size(), 1);
+}
+
 QTEST_APPLESS_MAIN(TestModifyFunction)
 
 #include "testmodifyfunction.moc"
@@ -35,6 +35,8 @@ class TestModifyFunction : public QObject
         void testRenameArgument();
         void invalidateAfterUse();
         void testGlobalFunctionModification();
+        void testModificationsFollowHierarchyChanges();
+        void testFrozenModificationCaches();
 };
 
 #endif
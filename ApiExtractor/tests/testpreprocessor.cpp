@@ -0,0 +1,167 @@
+/*
+* This file is part of the API Extractor project.
+*
+* Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+*
+* Contact: PySide team <contact@pyside.org>
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+* 02110-1301 USA
+*
+*/
+
+#include "testpreprocessor.h"
+#include <QtTest/QTest>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include "parser/rpp/pp.h"
+
+static QByteArray preprocess(const QByteArray& source)
+{
+    rpp::pp_environment env;
+    rpp::pp preprocess(env);
+    std::string result;
+    preprocess(source.constData(), source.constData() + source.size(),
+               rpp::pp_output_iterator<std::string>(result));
+    return QByteArray(result.c_str(), (int) result.size()).simplified();
+}
+
+static QString writeHeader(const QString& fileName, const QByteArray& contents)
+{
+    QDir dir(QDir::tempPath());
+    dir.mkpath("testpreprocessor");
+    dir.cd("testpreprocessor");
+    QString path = dir.absoluteFilePath(fileName);
+    QFile file(path);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        file.write(contents);
+    return path;
+}
+
+static QByteArray preprocessFile(const QString& fileName)
+{
+    rpp::pp_environment env;
+    rpp::pp preprocess(env);
+    std::string result;
+    preprocess.file(QFile::encodeName(fileName).constData(),
+                    rpp::pp_output_iterator<std::string>(result));
+    return QByteArray(result.c_str(), (int) result.size());
+}
+
+void TestPreprocessor::testMacroRedefinition()
+{
+    QByteArray result = preprocess("#define VALUE 1\n"
+                                   "#define VALUE 2\n"
+                                   "int a = VALUE;\n");
+    QVERIFY(result.contains("int a = 2;"));
+}
+
+void TestPreprocessor::testUndefinedMacro()
+{
+    // An #undef hides the macro, not only its latest definition.
+    QByteArray result = preprocess("#define VALUE 1\n"
+                                   "#define VALUE 2\n"
+                                   "#undef VALUE\n"
+                                   "#ifdef VALUE\n"
+                                   "int defined;\n"
+                                   "#endif\n"
+                                   "int a = VALUE;\n");
+    QVERIFY(!result.contains("defined"));
+    QVERIFY(result.contains("int a = VALUE;"));
+}
+
+void TestPreprocessor::testFunctionLikeMacro()
+{
+    QByteArray result = preprocess("#define ADD(x, y) (x + y)\n"
+                                   "#define CALL ADD\n"
+                                   "#define SELF SELF + 1\n"
+                                   "int a = CALL(1, 2);\n"
+                                   "int b = SELF;\n");
+    QVERIFY(result.contains("int a = (1 + 2);"));
+    QVERIFY(result.contains("int b = SELF + 1;"));
+}
+
+void TestPreprocessor::testInternedSymbols()
+{
+    const char name[] = "SOME_MACRO_NAME";
+    std::string copy(name);
+    const rpp::pp_fast_string* first = rpp::pp_symbol::intern(name, sizeof(name) - 1);
+    const rpp::pp_fast_string* second = rpp::pp_symbol::intern(copy.begin(), copy.end());
+    QCOMPARE(first, second);
+    QCOMPARE(first->hash_code(), rpp::pp_fast_string(copy.c_str(), copy.size()).hash_code());
+}
+
+void TestPreprocessor::testIncludeGuard()
+{
+    writeHeader("guarded.h", "/* license */\n"
+                             "#ifndef GUARDED_H\n"
+                             "#define GUARDED_H\n"
+                             "int guarded;\n"
+                             "#endif // GUARDED_H\n");
+    QString main = writeHeader("guardedmain.h", "#include \"guarded.h\"\n"
+                                                "#include \"guarded.h\"\n"
+                                                "#undef GUARDED_H\n"
+                                                "#include \"guarded.h\"\n");
+    QCOMPARE(preprocessFile(main).count("int guarded;"), 2);
+}
+
+void TestPreprocessor::testIncludeGuardWithTrailingCode()
+{
+    // Code after the guard's #endif must be seen on every inclusion.
+    writeHeader("trailing.h", "#ifndef TRAILING_H\n"
+                              "#define TRAILING_H\n"
+                              "int guarded;\n"
+                              "#endif\n"
+                              "int trailing;\n");
+    writeHeader("elsed.h", "#ifndef ELSED_H\n"
+                           "#define ELSED_H\n"
+                           "#else\n"
+                           "int elsed;\n"
+                           "#endif\n");
+    QString main = writeHeader("trailingmain.h", "#include \"trailing.h\"\n"
+                                                 "#include \"trailing.h\"\n"
+                                                 "#include \"elsed.h\"\n"
+                                                 "#include \"elsed.h\"\n");
+    QByteArray result = preprocessFile(main);
+    QCOMPARE(result.count("int guarded;"), 1);
+    QCOMPARE(result.count("int trailing;"), 2);
+    QCOMPARE(result.count("int elsed;"), 1);
+}
+
+void TestPreprocessor::testPragmaOnce()
+{
+    writeHeader("once.h", "#pragma once\n"
+                          "int once;\n");
+    QString main = writeHeader("oncemain.h", "#include \"once.h\"\n"
+                                             "#include \"./once.h\"\n");
+    QCOMPARE(preprocessFile(main).count("int once;"), 1);
+}
+
+void TestPreprocessor::benchmarkMacroExpansion()
+{
+    QByteArray source = "#define BASE(a, b) (a * b)\n"
+                        "#define Q_DECL_EXPORT\n";
+    for (int i = 0; i < 20000; ++i) {
+        source += QString("#define MACRO_%1(a) (a + BASE(a, %1))\n").arg(i).toAscii();
+        source += QString("Q_DECL_EXPORT int value%1 = MACRO_%1(%1) + MACRO_%2(1);\n").arg(i).arg(i / 2).toAscii();
+    }
+
+    QBENCHMARK {
+        preprocess(source);
+    }
+}
+
+QTEST_APPLESS_MAIN(TestPreprocessor)
+
+#include "testpreprocessor.moc"
@@ -0,0 +1,84 @@
+/*
+* This file is part of the API Extractor project.
+*
+* Copyright (C) 2009 Nokia Corporation and/or its subsidiary(-ies).
+*
+* Contact: PySide team <contact@pyside.org>
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+* 02110-1301 USA
+*
+*/
+
+#include "testqtdocparser.h"
+
+#include <QCoreApplication>
+#include <QtTest/QTest>
+#include "testutil.h"
+#include <qtdocparser.h>
+
+void TestQtDocParser::testFunctionDocumentation()
+{
+    const char* cppCode ="\
+    class B {\
+    public:\
+        enum Mode { Fast, Slow };\
+        void b();\
+        void b(int x) const;\
+        void b(const B& other, int* p);\
+        void c();\
+    };";
+    const char* xmlCode = "\
+    <typesystem package=\"Foo\">\
+        <primitive-type name='int'/>\
+        <value-type name='B'>\
+            <enum-type name='Mode'/>\
+        </value-type>\
+    </typesystem>";
+    TestUtil t(cppCode, xmlCode);
+
+    AbstractMetaClass* classB = t.builder()->classes().findClass("B");
+    QVERIFY(classB);
+    QtDocParser docParser;
+    docParser.setDocumentationDataDirectory(QDir::currentPath());
+    docParser.fillDocumentation(classB);
+
+    QCOMPARE(classB->documentation().value(), QString("<description>B</description>"));
+
+    QStringList docs;
+    foreach (const AbstractMetaFunction* func, classB->queryFunctionsByName("b"))
+        docs << func->documentation().value();
+    docs.sort();
+    QCOMPARE(docs, QStringList() << "<description>b()</description>"
+                                 << "<description>b(B, int*)</description>"
+                                 << "<description>b(int) const</description>");
+
+    const AbstractMetaFunction* funcC = classB->findFunction("c");
+    QVERIFY(funcC);
+    QVERIFY(funcC->documentation().value().isEmpty());
+
+    AbstractMetaEnum* metaEnum = classB->findEnum("Mode");
+    QVERIFY(metaEnum);
+    QCOMPARE(metaEnum->documentation().value(), QString("<description>Mode</description>"));
+}
+
+// Like testmodifydocumentation, use QCoreApplication instead of QApplication.
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+    TestQtDocParser tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "testqtdocparser.moc"
@@ -0,0 +1,230 @@
+/*
+* This file is part of the API Extractor project.
+*
+* Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+*
+* Contact: PySide team <contact@pyside.org>
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+* 02110-1301 USA
+*
+*/
+
+#include "testtranslationunits.h"
+#include <QtTest/QTest>
+#include <QtCore/QBuffer>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <cstring>
+#include "apiextractor.h"
+#include "abstractmetabuilder.h"
+#include "reporthandler.h"
+#include "typedatabase.h"
+
+static FileModelItem parseUnit(CodeModel* model, const char* cppCode)
+{
+    return AbstractMetaBuilder::parse(model, cppCode, std::strlen(cppCode));
+}
+
+static void parseTypeSystem(const char* xmlCode)
+{
+    ReportHandler::setSilent(true);
+    TypeDatabase* td = TypeDatabase::instance(true);
+    QBuffer buffer;
+    buffer.setData(xmlCode);
+    td->parseFile(&buffer);
+    buffer.close();
+}
+
+void TestTranslationUnits::testMergeTranslationUnits()
+{
+    const char* cppCode1 = "\
+    namespace Namespace {\
+        struct A { void methodA(); };\
+        enum Option { OpZero, OpOne };\
+    };";
+    const char* cppCode2 = "\
+    namespace Namespace {\
+        struct B { void methodB(); };\
+    };\
+    void globalFunc(int);";
+    const char* xmlCode = "\
+    <typesystem package='Foo'> \
+        <primitive-type name='int' />\
+        <namespace-type name='Namespace'>\
+            <value-type name='A' /> \
+            <value-type name='B' /> \
+            <enum-type name='Option' /> \
+        </namespace-type>\
+        <function signature='globalFunc(int)' />\
+    </typesystem>";
+    parseTypeSystem(xmlCode);
+
+    CodeModel model1;
+    CodeModel model2;
+    FileList units;
+    units << parseUnit(&model1, cppCode1) << parseUnit(&model2, cppCode2);
+
+    AbstractMetaBuilder builder;
+    QVERIFY(builder.build(units));
+
+    AbstractMetaClassList classes = builder.classes();
+    AbstractMetaClass* ns = classes.findClass("Namespace");
+    QVERIFY(ns);
+    QVERIFY(ns->findEnum("Option"));
+    AbstractMetaClass* classA = classes.findClass("Namespace::A");
+    QVERIFY(classA);
+    QVERIFY(classA->findFunction("methodA"));
+    AbstractMetaClass* classB = classes.findClass("Namespace::B");
+    QVERIFY(classB);
+    QVERIFY(classB->findFunction("methodB"));
+    QCOMPARE(builder.globalFunctions().size(), 1);
+}
+
+void TestTranslationUnits::testSharedDeclarationsAreMergedOnce()
+{
+    // Both units include the same header.
+    const char* cppCode = "\
+    struct Shared { void method(); };\
+    void sharedFunc(Shared*);";
+    const char* xmlCode = "\
+    <typesystem package='Foo'> \
+        <object-type name='Shared' /> \
+        <function signature='sharedFunc(Shared*)' />\
+    </typesystem>";
+    parseTypeSystem(xmlCode);
+
+    CodeModel model1;
+    CodeModel model2;
+    FileList units;
+    units << parseUnit(&model1, cppCode) << parseUnit(&model2, cppCode);
+
+    AbstractMetaBuilder builder;
+    QVERIFY(builder.build(units));
+
+    AbstractMetaClassList classes = builder.classes();
+    QCOMPARE(classes.size(), 1);
+    AbstractMetaClass* shared = classes.findClass("Shared");
+    QVERIFY(shared);
+    QCOMPARE(shared->queryFunctionsByName("method").size(), 1);
+    QCOMPARE(builder.globalFunctions().size(), 1);
+}
+
+static bool writeFile(const QString& fileName, const QByteArray& contents)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    return file.write(contents) == contents.size();
+}
+
+// Runs an extractor on the given headers and returns a sorted description of everything it found.
+static QStringList extract(const QString& typeSystem, const QStringList& headers, const QString& includePath)
+{
+    TypeDatabase::instance(true);
+    ApiExtractor extractor;
+    extractor.setSilent(true);
+    extractor.setTypeSystem(typeSystem);
+    extractor.setCppFileNames(headers);
+    extractor.addIncludePath(includePath);
+    if (!extractor.run())
+        return QStringList();
+
+    QStringList result;
+    foreach (const AbstractMetaClass* metaClass, extractor.classes()) {
+        result << metaClass->qualifiedCppName();
+        foreach (const AbstractMetaFunction* func, metaClass->functions())
+            result << metaClass->qualifiedCppName() + "::" + func->minimalSignature();
+        foreach (const AbstractMetaEnum* metaEnum, metaClass->enums()) {
+            foreach (const AbstractMetaEnumValue* value, metaEnum->values())
+                result << metaClass->qualifiedCppName() + "::" + metaEnum->name() + "::" + value->name();
+        }
+    }
+    foreach (const AbstractMetaFunction* func, extractor.globalFunctions())
+        result << func->minimalSignature();
+    foreach (const AbstractMetaEnum* metaEnum, extractor.globalEnums())
+        result << metaEnum->name();
+    qSort(result);
+    return result;
+}
+
+void TestTranslationUnits::testParallelParsingMatchesSerialParsing()
+{
+    const int unitCount = 8;
+    QDir dir(QDir::temp());
+    QString dirName = QString("testtranslationunits-%1").arg(QCoreApplication::applicationPid());
+    QVERIFY(dir.mkpath(dirName));
+    QVERIFY(dir.cd(dirName));
+
+    // Every unit includes the same guarded header and relies on "defined" in conditionals,
+    // which keeps the preprocessors of concurrent units busy with the same constructs.
+    QVERIFY(writeFile(dir.filePath("common.h"), "\
+    #ifndef COMMON_H\n\
+    #define COMMON_H\n\
+    namespace Namespace { struct Common { void method(int); }; }\n\
+    #endif\n"));
+
+    QByteArray xmlCode = "<typesystem package='Foo'>\n"
+                         "<primitive-type name='int'/>\n"
+                         "<namespace-type name='Namespace'>\n"
+                         "<value-type name='Common'/>\n";
+    QByteArray allCode;
+    QStringList headers;
+    for (int i = 0; i < unitCount; ++i) {
+        QByteArray n = QByteArray::number(i);
+        QByteArray cppCode = "#include \"common.h\"\n"
+                             "#define UNIT_" + n + "_ENABLED\n"
+                             "#if defined(UNIT_" + n + "_ENABLED) && !defined UNIT_" + n + "_DISABLED\n"
+                             "namespace Namespace {\n"
+                             "struct Unit" + n + " {\n"
+                             "    enum Option { Zero" + n + ", One" + n + " };\n"
+                             "    void method" + n + "(int);\n"
+                             "    int value" + n + "() const;\n"
+                             "};\n"
+                             "}\n"
+                             "void unitFunction" + n + "(Namespace::Unit" + n + "*);\n"
+                             "#endif\n";
+        QString header = dir.filePath(QString("unit%1.h").arg(i));
+        QVERIFY(writeFile(header, cppCode));
+        headers << header;
+        allCode += "#include \"unit" + n + ".h\"\n";
+        xmlCode += "<value-type name='Unit" + n + "'><enum-type name='Option'/></value-type>\n";
+    }
+    xmlCode += "</namespace-type>\n";
+    for (int i = 0; i < unitCount; ++i)
+        xmlCode += "<function signature='unitFunction" + QByteArray::number(i) + "(Namespace::Unit" + QByteArray::number(i) + "*)'/>\n";
+    xmlCode += "</typesystem>\n";
+
+    QString typeSystem = dir.filePath("typesystem_foo.xml");
+    QVERIFY(writeFile(typeSystem, xmlCode));
+    QString allHeader = dir.filePath("all.h");
+    QVERIFY(writeFile(allHeader, allCode));
+
+    QStringList serial = extract(typeSystem, QStringList(allHeader), dir.absolutePath());
+    QStringList parallel = extract(typeSystem, headers, dir.absolutePath());
+
+    foreach (QString fileName, dir.entryList(QDir::Files))
+        dir.remove(fileName);
+    QDir::temp().rmdir(dirName);
+
+    QVERIFY(serial.contains("Namespace::Common"));
+    QVERIFY(serial.contains("Namespace::Unit7"));
+    QVERIFY(serial.size() > unitCount * 5);
+    QCOMPARE(parallel, serial);
+}
+
+QTEST_APPLESS_MAIN(TestTranslationUnits)
+
+#include "testtranslationunits.moc"
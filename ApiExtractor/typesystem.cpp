@@ -25,6 +25,7 @@
 #include "typesystem_p.h"
 #include "typedatabase.h"
 #include "reporthandler.h"
+#include "codesniptemplate.h"
 #include <QtXml>
 
 static QString strings_Object = QLatin1String("Object");
@@ -514,6 +515,7 @@ bool Handler::startElement(const QString &, const QString &n,
             break;
         case StackElement::ContainerTypeEntry:
             attributes["type"] = QString();
+            attributes["view"] = "no";
             break;
         case StackElement::EnumTypeEntry:
             attributes["flags"] = QString();
@@ -526,6 +528,7 @@ bool Handler::startElement(const QString &, const QString &n,
             break;
         case StackElement::ValueTypeEntry:
             attributes["default-constructor"] = QString();
+            attributes["copy-cache"] = QString("no");
             // fall throooough
         case StackElement::ObjectTypeEntry:
             attributes["force-abstract"] = QString("no");
@@ -677,6 +680,7 @@ bool Handler::startElement(const QString &, const QString &n,
 
                 ContainerTypeEntry *type = new ContainerTypeEntry(name, containerType, since);
                 type->setCodeGeneration(m_generate);
+                type->setReturnsView(convertBoolean(attributes["view"], "view", false));
                 element->entry = type;
             }
             break;
@@ -822,6 +826,11 @@ bool Handler::startElement(const QString &, const QString &n,
                     ctype->setTypeFlags(ctype->typeFlags() | ComplexTypeEntry::Deprecated);
             }
 
+            if (element->type == StackElement::ValueTypeEntry
+                && convertBoolean(attributes["copy-cache"], "copy-cache", false)) {
+                ctype->setTypeFlags(ctype->typeFlags() | ComplexTypeEntry::CopyCache);
+            }
+
             if (element->type == StackElement::InterfaceTypeEntry
                 || element->type == StackElement::ValueTypeEntry
                 || element->type == StackElement::ObjectTypeEntry) {
@@ -1000,6 +1009,7 @@ bool Handler::startElement(const QString &, const QString &n,
             attributes["index"] = QString();
             attributes["replace-value"] = QString();
             attributes["invalidate-after-use"] = QString("no");
+            attributes["view"] = QString("no");
             break;
         case StackElement::ModifyField:
             attributes["name"] = QString();
@@ -1263,9 +1273,16 @@ bool Handler::startElement(const QString &, const QString &n,
                 return false;
             }
 
+            bool view = convertBoolean(attributes["view"], "view", false);
+            if (view && idx) {
+                m_error = QString("view is only supported for return values (index=0).");
+                return false;
+            }
+
             ArgumentModification argumentModification = ArgumentModification(idx, since);
             argumentModification.replace_value = replace_value;
             argumentModification.resetAfterUse = convertBoolean(attributes["invalidate-after-use"], "invalidate-after-use", false);
+            argumentModification.view = view;
             m_contextStack.top()->functionMods.last().argument_mods.append(argumentModification);
         }
         break;
@@ -2036,6 +2053,18 @@ QString CodeSnipAbstract::code() const
     return res;
 }
 
+const CodeSnipTemplate& CodeSnipAbstract::codeTemplate() const
+{
+    if (!m_parsedCode->codeTemplate)
+        m_parsedCode->codeTemplate = new CodeSnipTemplate(code());
+    return *m_parsedCode->codeTemplate;
+}
+
+CodeSnipAbstract::ParsedCode::~ParsedCode()
+{
+    delete codeTemplate;
+}
+
 QString CodeSnipFragment::code() const
 {
     if (m_instance)
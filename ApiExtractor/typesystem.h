@@ -29,6 +29,7 @@
 #include <QtCore/QStringList>
 #include <QtCore/QMap>
 #include <QtCore/QDebug>
+#include <QtCore/QSharedPointer>
 #include "include.h"
 
 //Used to identify the conversion rule to avoid break API
@@ -46,6 +47,7 @@ class FlagsTypeEntry;
 typedef QMap<int, QString> ArgumentMap;
 
 class TemplateInstance;
+class CodeSnipTemplate;
 
 namespace TypeSystem
 {
@@ -140,19 +142,46 @@ public:
 class CodeSnipAbstract
 {
 public:
+    CodeSnipAbstract() : m_parsedCode(new ParsedCode) { }
+
     QString code() const;
 
+    /**
+     *   Returns code() split into literal text and type system variables.
+     *   The template is built on first use and shared with every copy of
+     *   the snippet, so a snippet injected in many functions is scanned once.
+     *   Not thread-safe.
+     */
+    const CodeSnipTemplate& codeTemplate() const;
+
     void addCode(const QString &code)
     {
         codeList.append(CodeSnipFragment(code));
+        codeChanged();
     }
 
     void addTemplateInstance(TemplateInstance *ti)
     {
         codeList.append(CodeSnipFragment(ti));
+        codeChanged();
+    }
+
+    /// Must be called after changing codeList directly.
+    void codeChanged()
+    {
+        m_parsedCode = QSharedPointer<ParsedCode>(new ParsedCode);
     }
 
     QList<CodeSnipFragment> codeList;
+
+private:
+    struct ParsedCode
+    {
+        ParsedCode() : codeTemplate(0) { }
+        ~ParsedCode();
+        CodeSnipTemplate* codeTemplate;
+    };
+    QSharedPointer<ParsedCode> m_parsedCode;
 };
 
 class CustomFunction : public CodeSnipAbstract
@@ -248,13 +277,15 @@ struct ArgumentModification
 {
     ArgumentModification(int idx, double vr)
             : removedDefaultExpression(false), removed(false),
-              noNullPointers(false), index(idx), version(vr) {}
+              noNullPointers(false), view(false), index(idx), version(vr) {}
 
     // Should the default expression be removed?
     uint removedDefaultExpression : 1;
     uint removed : 1;
     uint noNullPointers : 1;
     uint resetAfterUse : 1;
+    // Should a returned container be wrapped in a read-only view instead of being converted?
+    uint view : 1;
 
     // The index of this argument
     int index;
@@ -1407,7 +1438,8 @@ public:
     enum TypeFlag {
         ForceAbstract      = 0x1,
         DeleteInMainThread = 0x2,
-        Deprecated         = 0x4
+        Deprecated         = 0x4,
+        CopyCache          = 0x8
     };
     typedef QFlags<TypeFlag> TypeFlags;
 
@@ -1688,7 +1720,7 @@ public:
     };
 
     ContainerTypeEntry(const QString &name, Type type, double vr)
-        : ComplexTypeEntry(name, ContainerType, vr), m_type(type)
+        : ComplexTypeEntry(name, ContainerType, vr), m_type(type), m_returnsView(false)
     {
         setCodeGeneration(GenerateForSubclass);
     }
@@ -1698,6 +1730,16 @@ public:
         return m_type;
     }
 
+    /// Returns true if C++ values of this container are given to Python as read-only views.
+    bool returnsView() const
+    {
+        return m_returnsView;
+    }
+    void setReturnsView(bool returnsView)
+    {
+        m_returnsView = returnsView;
+    }
+
     QString typeName() const;
     QString targetLangName() const;
     QString targetLangPackage() const;
@@ -1725,6 +1767,7 @@ public:
 
 private:
     Type m_type;
+    bool m_returnsView;
 };
 
 typedef QList<const ContainerTypeEntry*> ContainerTypeEntryList;
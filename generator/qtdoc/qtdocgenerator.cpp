@@ -27,6 +27,15 @@
 #include <doxygenparser.h>
 #include <typedatabase.h>
 #include <algorithm>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QFileInfo>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSet>
+#include <QtCore/QThreadPool>
+#include <QtCore/QThreadStorage>
+#include <QtCore/QtConcurrentMap>
 #include <QtCore/QStack>
 #include <QtCore/QTextStream>
 #include <QtCore/QXmlStreamReader>
@@ -35,7 +44,15 @@
 #include <fileout.h>
 #include <limits>
 
-static Indentor INDENT;
+// Classes are documented in parallel, so each thread keeps its own indentation level.
+static QThreadStorage<Indentor*> indentors;
+
+static Indentor& indentor()
+{
+    if (!indentors.hasLocalData())
+        indentors.setLocalData(new Indentor);
+    return *indentors.localData();
+}
 
 static bool shouldSkip(const AbstractMetaFunction* func)
 {
@@ -100,7 +117,8 @@ static QString escape(const QStringRef& strref)
 
 
 QtXmlToSphinx::QtXmlToSphinx(QtDocGenerator* generator, const QString& doc, const QString& context)
-        : m_context(context), m_generator(generator), m_insideBold(false), m_insideItalic(false)
+        : m_context(context), m_generator(generator), m_insideBold(false), m_insideItalic(false),
+          m_headingType('-')
 {
     m_handlerMap.insert("heading", &QtXmlToSphinx::handleHeadingTag);
     m_handlerMap.insert("brief", &QtXmlToSphinx::handleParaTag);
@@ -194,13 +212,7 @@ QString QtXmlToSphinx::expandFunction(const QString& function)
 {
     QStringList functionSpec = function.split('.');
     QString className = functionSpec.first();
-    const AbstractMetaClass* metaClass = 0;
-    foreach (const AbstractMetaClass* cls, m_generator->classes()) {
-        if (cls->name() == className) {
-            metaClass = cls;
-            break;
-        }
-    }
+    const AbstractMetaClass* metaClass = m_generator->findClassByName(className);
 
     if (metaClass) {
         functionSpec.removeFirst();
@@ -214,13 +226,7 @@ QString QtXmlToSphinx::resolveContextForMethod(const QString& methodName)
 {
     QString currentClass = m_context.split(".").last();
 
-    const AbstractMetaClass* metaClass = 0;
-    foreach (const AbstractMetaClass* cls, m_generator->classes()) {
-        if (cls->name() == currentClass) {
-            metaClass = cls;
-            break;
-        }
-    }
+    const AbstractMetaClass* metaClass = m_generator->findClassByName(currentClass);
 
     if (metaClass) {
         QList<const AbstractMetaFunction*> funcList;
@@ -246,7 +252,7 @@ QString QtXmlToSphinx::resolveContextForMethod(const QString& methodName)
 QString QtXmlToSphinx::transform(const QString& doc)
 {
     Q_ASSERT(m_buffers.isEmpty());
-    Indentation indentation(INDENT);
+    Indentation indentation(indentor());
     if (doc.trimmed().isEmpty())
         return doc;
 
@@ -257,7 +263,7 @@ QString QtXmlToSphinx::transform(const QString& doc)
     while (!reader.atEnd()) {
         QXmlStreamReader::TokenType token = reader.readNext();
         if (reader.hasError()) {
-            m_output << INDENT << "XML Error: " + reader.errorString() + "\n" + doc;
+            m_output << indentor() << "XML Error: " + reader.errorString() + "\n" + doc;
             ReportHandler::warning("XML Error: " + reader.errorString() + "\n" + doc);
             break;
         }
@@ -285,80 +291,54 @@ QString QtXmlToSphinx::transform(const QString& doc)
     return retval;
 }
 
-QString QtXmlToSphinx::readFromLocations(const QStringList& locations, const QString& path, const QString& identifier)
+QString QtXmlToSphinx::readFromLocations(const QString& path, const QString& identifier)
 {
-    QString result;
-    bool ok;
-    foreach (QString location, locations) {
-        location.append('/');
-        location.append(path);
-        result = readFromLocation(location, identifier, &ok);
-        if (ok)
-            break;
+    foreach (QString location, m_generator->codeSnippetDirs())
+        m_codeFiles << location + '/' + path;
+    QString location = m_generator->resolveCodeSnippetPath(path);
+    if (location.isEmpty()) {
+        ReportHandler::warning("Couldn't read code snippet file: {"
+                               + m_generator->codeSnippetDirs().join("|") + '}' + path);
+        return QString();
     }
-    if (!ok)
-        ReportHandler::warning("Couldn't read code snippet file: {"+ locations.join("|") + '}' + path);
-    return result;
+    return readFromLocation(location, identifier);
 }
 
-QString QtXmlToSphinx::readFromLocation(const QString& location, const QString& identifier, bool* ok)
+QString QtXmlToSphinx::readFromLocation(const QString& location, const QString& identifier)
 {
-    QFile inputFile;
-    inputFile.setFileName(location);
-    if (!inputFile.open(QIODevice::ReadOnly)) {
-        if (!ok)
-            ReportHandler::warning("Couldn't read code snippet file: "+inputFile.fileName());
-        else
-            *ok = false;
+    m_codeFiles << location;
+    CodeSnippetFile snippetFile = m_generator->codeSnippetFile(location);
+    if (!snippetFile.isValid) {
+        ReportHandler::warning("Couldn't read code snippet file: " + location);
         return QString();
     }
 
-    QRegExp searchString("//!\\s*\\[" + identifier + "\\]");
-    QRegExp codeSnippetCode("//!\\s*\\[[\\w\\d\\s]+\\]");
-    QString code;
-    QString line;
-    bool identifierIsEmpty = identifier.isEmpty();
-    bool getCode = false;
+    if (identifier.isEmpty())
+        return snippetFile.contents;
 
-    while (!inputFile.atEnd()) {
-        line = inputFile.readLine();
-        if (identifierIsEmpty) {
-            code += line;
-        } else if (getCode && !line.contains(searchString)) {
-            code += line.replace(codeSnippetCode, "");
-        } else if (line.contains(searchString)) {
-            if (getCode)
-                break;
-            else
-                getCode = true;
-        }
-    }
-
-    if (!identifierIsEmpty && !getCode)
+    QHash<QString, QString>::const_iterator it = snippetFile.snippets.find(identifier);
+    if (it == snippetFile.snippets.end()) {
         ReportHandler::warning("Code snippet file found ("+location+"), but snippet "+ identifier +" not found.");
-
-    if (ok)
-        *ok = true;
-    return code;
+        return QString();
+    }
+    return it.value();
 }
 
 void QtXmlToSphinx::handleHeadingTag(QXmlStreamReader& reader)
 {
-    static QString heading;
-    static char type;
-    static char types[] = { '-', '^' };
+    static const char types[] = { '-', '^' };
     QXmlStreamReader::TokenType token = reader.tokenType();
     if (token == QXmlStreamReader::StartElement) {
         uint typeIdx = reader.attributes().value("level").toString().toInt();
         if (typeIdx >= sizeof(types))
-            type = types[sizeof(types)-1];
+            m_headingType = types[sizeof(types)-1];
         else
-            type = types[typeIdx];
+            m_headingType = types[typeIdx];
     } else if (token == QXmlStreamReader::EndElement) {
-        m_output << createRepeatedChar(heading.length(), type) << endl << endl;
+        m_output << createRepeatedChar(m_heading.length(), m_headingType) << endl << endl;
     } else if (token == QXmlStreamReader::Characters) {
-        heading = escape(reader.text()).trimmed();
-        m_output << endl << endl << heading << endl;
+        m_heading = escape(reader.text()).trimmed();
+        m_output << endl << endl << m_heading << endl;
     }
 }
 
@@ -374,7 +354,7 @@ void QtXmlToSphinx::handleParaTag(QXmlStreamReader& reader)
         else if (result.startsWith("**Note:**"))
             result.replace(0, 9, ".. note:: ");
 
-        m_output << INDENT << result << endl << endl;
+        m_output << indentor() << result << endl << endl;
     } else if (token == QXmlStreamReader::Characters) {
         QString text = escape(reader.text());
         if (!m_output.string()->isEmpty()) {
@@ -383,7 +363,7 @@ void QtXmlToSphinx::handleParaTag(QXmlStreamReader& reader)
             if ((end == '*' || end == '`') && start != ' ' && !start.isPunct())
                 m_output << '\\';
         }
-        m_output << INDENT << text;
+        m_output << indentor() << text;
     }
 }
 
@@ -422,7 +402,7 @@ void QtXmlToSphinx::handleSeeAlsoTag(QXmlStreamReader& reader)
 {
     QXmlStreamReader::TokenType token = reader.tokenType();
     if (token == QXmlStreamReader::StartElement)
-        m_output << INDENT << ".. seealso:: ";
+        m_output << indentor() << ".. seealso:: ";
     else if (token == QXmlStreamReader::EndElement)
         m_output << endl;
 }
@@ -438,17 +418,17 @@ void QtXmlToSphinx::handleSnippetTag(QXmlStreamReader& reader)
         }
         QString location = reader.attributes().value("location").toString();
         QString identifier = reader.attributes().value("identifier").toString();
-        QString code = readFromLocations(m_generator->codeSnippetDirs(), location, identifier);
+        QString code = readFromLocations(location, identifier);
         if (!consecutiveSnippet)
-            m_output << INDENT << "::\n\n";
+            m_output << indentor() << "::\n\n";
 
-        Indentation indentation(INDENT);
+        Indentation indentation(indentor());
         if (code.isEmpty()) {
-            m_output << INDENT << "<Code snippet \"" << location << ':' << identifier << "\" not found>" << endl;
+            m_output << indentor() << "<Code snippet \"" << location << ':' << identifier << "\" not found>" << endl;
         } else {
             foreach (QString line, code.split("\n")) {
                 if (!QString(line).trimmed().isEmpty())
-                    m_output << INDENT << line;
+                    m_output << indentor() << line;
 
                 m_output << endl;
             }
@@ -465,9 +445,9 @@ void QtXmlToSphinx::handleDotsTag(QXmlStreamReader& reader)
             m_output.flush();
             m_output.string()->chop(2);
         }
-        Indentation indentation(INDENT);
+        Indentation indentation(indentor());
         pushOutputBuffer();
-        m_output << INDENT;
+        m_output << indentor();
         int indent = reader.attributes().value("indent").toString().toInt();
         for (int i = 0; i < indent; ++i)
             m_output << ' ';
@@ -542,28 +522,27 @@ void QtXmlToSphinx::handleRowTag(QXmlStreamReader& reader)
 void QtXmlToSphinx::handleListTag(QXmlStreamReader& reader)
 {
     // BUG We do not support a list inside a table cell
-    static QString listType;
     QXmlStreamReader::TokenType token = reader.tokenType();
     if (token == QXmlStreamReader::StartElement) {
-        listType = reader.attributes().value("type").toString();
-        if (listType == "enum") {
+        m_listType = reader.attributes().value("type").toString();
+        if (m_listType == "enum") {
             m_currentTable << (TableRow() << "Constant" << "Description");
             m_tableHasHeader = true;
         }
-        INDENT.indent--;
+        indentor().indent--;
     } else if (token == QXmlStreamReader::EndElement) {
-        INDENT.indent++;
+        indentor().indent++;
         if (!m_currentTable.isEmpty()) {
-            if (listType == "bullet") {
+            if (m_listType == "bullet") {
                 m_output << endl;
                 foreach (TableCell cell, m_currentTable.first()) {
                     QStringList itemLines = cell.data.split('\n');
-                    m_output << INDENT << "* " << itemLines.first() << endl;
+                    m_output << indentor() << "* " << itemLines.first() << endl;
                     for (int i = 1, max = itemLines.count(); i < max; ++i)
-                        m_output << INDENT << "  " << itemLines[i] << endl;
+                        m_output << indentor() << "  " << itemLines[i] << endl;
                 }
                 m_output << endl;
-            } else if (listType == "enum") {
+            } else if (m_listType == "enum") {
                 m_currentTable.enableHeader(m_tableHasHeader);
                 m_currentTable.normalize();
                 m_output << m_currentTable;
@@ -575,94 +554,89 @@ void QtXmlToSphinx::handleListTag(QXmlStreamReader& reader)
 
 void QtXmlToSphinx::handleLinkTag(QXmlStreamReader& reader)
 {
-    static QString l_linktag;
-    static QString l_linkref;
-    static QString l_linktext;
-    static QString l_linktagending;
-    static QString l_type;
     QXmlStreamReader::TokenType token = reader.tokenType();
     if (token == QXmlStreamReader::StartElement) {
-        l_linktagending = "` ";
+        m_linkTagEnding = "` ";
         if (m_insideBold) {
-            l_linktag.prepend("**");
-            l_linktagending.append("**");
+            m_linkTag.prepend("**");
+            m_linkTagEnding.append("**");
         } else if (m_insideItalic) {
-            l_linktag.prepend('*');
-            l_linktagending.append('*');
+            m_linkTag.prepend('*');
+            m_linkTagEnding.append('*');
         }
-        l_type = reader.attributes().value("type").toString();
+        m_linkType = reader.attributes().value("type").toString();
 
         // TODO: create a flag PROPERTY-AS-FUNCTION to ask if the properties
         // are recognized as such or not in the binding
-        if (l_type == "property")
-            l_type = "function";
+        if (m_linkType == "property")
+            m_linkType = "function";
 
-        if (l_type == "typedef")
-            l_type = "class";
+        if (m_linkType == "typedef")
+            m_linkType = "class";
 
         QString linkSource;
-        if (l_type == "function" || l_type == "class") {
+        if (m_linkType == "function" || m_linkType == "class") {
             linkSource  = "raw";
-        } else if (l_type == "enum") {
+        } else if (m_linkType == "enum") {
             linkSource  = "enum";
-        } else if (l_type == "page") {
+        } else if (m_linkType == "page") {
             linkSource  = "page";
         } else {
             linkSource = "href";
         }
 
-        l_linkref = reader.attributes().value(linkSource).toString();
-        l_linkref.replace("::", ".");
-        l_linkref.remove("()");
+        m_linkRef = reader.attributes().value(linkSource).toString();
+        m_linkRef.replace("::", ".");
+        m_linkRef.remove("()");
 
-        if (l_type == "function" && !m_context.isEmpty()) {
-            l_linktag = " :meth:`";
-            QStringList rawlinklist = l_linkref.split(".");
+        if (m_linkType == "function" && !m_context.isEmpty()) {
+            m_linkTag = " :meth:`";
+            QStringList rawlinklist = m_linkRef.split(".");
             if (rawlinklist.size() == 1 || rawlinklist.first() == m_context) {
                 QString context = resolveContextForMethod(rawlinklist.last());
-                if (!l_linkref.startsWith(context))
-                    l_linkref.prepend(context + '.');
+                if (!m_linkRef.startsWith(context))
+                    m_linkRef.prepend(context + '.');
             } else {
-                l_linkref = expandFunction(l_linkref);
+                m_linkRef = expandFunction(m_linkRef);
             }
-        } else if (l_type == "function" && m_context.isEmpty()) {
-            l_linktag = " :func:`";
-        } else if (l_type == "class") {
-            l_linktag = " :class:`";
-            TypeEntry* type = TypeDatabase::instance()->findType(l_linkref);
+        } else if (m_linkType == "function" && m_context.isEmpty()) {
+            m_linkTag = " :func:`";
+        } else if (m_linkType == "class") {
+            m_linkTag = " :class:`";
+            TypeEntry* type = TypeDatabase::instance()->findType(m_linkRef);
             if (type) {
-                l_linkref = type->qualifiedTargetLangName();
+                m_linkRef = type->qualifiedTargetLangName();
             } else { // fall back to the old heuristic if the type wasn't found.
-                QStringList rawlinklist = l_linkref.split(".");
+                QStringList rawlinklist = m_linkRef.split(".");
                 QStringList splittedContext = m_context.split(".");
                 if (rawlinklist.size() == 1 || rawlinklist.first() == splittedContext.last()) {
                     splittedContext.removeLast();
-                    l_linkref.prepend('~' + splittedContext.join(".") + '.');
+                    m_linkRef.prepend('~' + splittedContext.join(".") + '.');
                 }
             }
-        } else if (l_type == "enum") {
-            l_linktag = " :attr:`";
-        } else if (l_type == "page" && l_linkref == m_generator->moduleName()) {
-            l_linktag = " :mod:`";
+        } else if (m_linkType == "enum") {
+            m_linkTag = " :attr:`";
+        } else if (m_linkType == "page" && m_linkRef == m_generator->moduleName()) {
+            m_linkTag = " :mod:`";
         } else {
-            l_linktag = " :ref:`";
+            m_linkTag = " :ref:`";
         }
 
     } else if (token == QXmlStreamReader::Characters) {
         QString linktext = reader.text().toString();
         linktext.replace("::", ".");
-        QString item = l_linkref.split(".").last();
-        if (l_linkref == linktext
-            || (l_linkref + "()") == linktext
+        QString item = m_linkRef.split(".").last();
+        if (m_linkRef == linktext
+            || (m_linkRef + "()") == linktext
             || item == linktext
             || (item + "()") == linktext)
-            l_linktext.clear();
+            m_linkText.clear();
         else
-            l_linktext = linktext + QLatin1String("<");
+            m_linkText = linktext + QLatin1String("<");
     } else if (token == QXmlStreamReader::EndElement) {
-        if (!l_linktext.isEmpty())
-            l_linktagending.prepend('>');
-        m_output << l_linktag << l_linktext << escape(l_linkref) << l_linktagending;
+        if (!m_linkText.isEmpty())
+            m_linkTagEnding.prepend('>');
+        m_output << m_linkTag << m_linkText << escape(m_linkRef) << m_linkTagEnding;
     }
 }
 
@@ -675,7 +649,7 @@ void QtXmlToSphinx::handleImageTag(QXmlStreamReader& reader)
         QString imgPath = dir.relativeFilePath(m_generator->libSourceDir() + "/doc/src/") + '/' + href;
 
         if (reader.name() == "image")
-            m_output << INDENT << ".. image:: " <<  imgPath << endl << endl;
+            m_output << indentor() << ".. image:: " <<  imgPath << endl << endl;
         else
             m_output << ".. image:: " << imgPath << ' ';
     }
@@ -686,11 +660,11 @@ void QtXmlToSphinx::handleRawTag(QXmlStreamReader& reader)
     QXmlStreamReader::TokenType token = reader.tokenType();
     if (token == QXmlStreamReader::StartElement) {
         QString format = reader.attributes().value("format").toString();
-        m_output << INDENT << ".. raw:: " << format.toLower() << endl << endl;
+        m_output << indentor() << ".. raw:: " << format.toLower() << endl << endl;
     } else if (token == QXmlStreamReader::Characters) {
         QStringList lst(reader.text().toString().split("\n"));
         foreach(QString row, lst)
-            m_output << INDENT << INDENT << row << endl;
+            m_output << indentor() << indentor() << row << endl;
     } else if (token == QXmlStreamReader::EndElement) {
         m_output << endl << endl;
     }
@@ -701,15 +675,15 @@ void QtXmlToSphinx::handleCodeTag(QXmlStreamReader& reader)
     QXmlStreamReader::TokenType token = reader.tokenType();
     if (token == QXmlStreamReader::StartElement) {
         QString format = reader.attributes().value("format").toString();
-        m_output << INDENT << "::" << endl << endl;
-        INDENT.indent++;
+        m_output << indentor() << "::" << endl << endl;
+        indentor().indent++;
     } else if (token == QXmlStreamReader::Characters) {
         QStringList lst(reader.text().toString().split("\n"));
         foreach(QString row, lst)
-            m_output << INDENT << INDENT << row << endl;
+            m_output << indentor() << indentor() << row << endl;
     } else if (token == QXmlStreamReader::EndElement) {
         m_output << endl << endl;
-        INDENT.indent--;
+        indentor().indent--;
     }
 }
 
@@ -755,7 +729,7 @@ void QtXmlToSphinx::handleAnchorTag(QXmlStreamReader& reader)
             anchor = reader.attributes().value("name").toString();
         if (!anchor.isEmpty() && m_opened_anchor != anchor) {
             m_opened_anchor = anchor;
-            m_output << INDENT << ".. _" << m_context << "_" << anchor.toLower() << ":" << endl << endl;
+            m_output << indentor() << ".. _" << m_context << "_" << anchor.toLower() << ":" << endl << endl;
         }
    } else if (token == QXmlStreamReader::EndElement) {
        m_opened_anchor = "";
@@ -771,14 +745,14 @@ void QtXmlToSphinx::handleQuoteFileTag(QXmlStreamReader& reader)
         location.prepend(m_generator->libSourceDir() + '/');
         QString code = readFromLocation(location, identifier);
 
-        m_output << INDENT << "::\n\n";
-        Indentation indentation(INDENT);
+        m_output << indentor() << "::\n\n";
+        Indentation indentation(indentor());
         if (code.isEmpty()) {
-            m_output << INDENT << "<Code snippet \"" << location << "\" not found>" << endl;
+            m_output << indentor() << "<Code snippet \"" << location << "\" not found>" << endl;
         } else {
             foreach (QString line, code.split("\n")) {
                 if (!QString(line).trimmed().isEmpty())
-                    m_output << INDENT << line;
+                    m_output << indentor() << line;
 
                 m_output << endl;
             }
@@ -878,7 +852,7 @@ QTextStream& operator<<(QTextStream& s, const QtXmlToSphinx::Table &table)
         const QtXmlToSphinx::TableRow& row = table[i];
 
         // print line
-        s << INDENT << '+';
+        s << indentor() << '+';
         for (int col = 0, max = colWidths.count(); col < max; ++col) {
             char c;
             if (col >= row.length() || row[col].rowSpan == -1)
@@ -898,7 +872,7 @@ QTextStream& operator<<(QTextStream& s, const QtXmlToSphinx::Table &table)
                 const QtXmlToSphinx::TableCell& cell = row[j];
                 QStringList rowLines = cell.data.split('\n'); // FIXME: Cache this!!!
                 if (!j) // First column, so we need print the identation
-                    s << INDENT;
+                    s << indentor();
 
                 if (!j || !cell.colSpan)
                     s << '|';
@@ -911,50 +885,52 @@ QTextStream& operator<<(QTextStream& s, const QtXmlToSphinx::Table &table)
             s << '|' << endl;
         }
     }
-    s << INDENT << horizontalLine << endl;
+    s << indentor() << horizontalLine << endl;
     s << endl;
     return s;
 }
 
-static QString getFuncName(const AbstractMetaFunction* cppFunc) {
-    static bool hashInitialized = false;
-    static QHash<QString, QString> operatorsHash;
-    if (!hashInitialized) {
-        operatorsHash.insert("operator+", "__add__");
-        operatorsHash.insert("operator+=", "__iadd__");
-        operatorsHash.insert("operator-", "__sub__");
-        operatorsHash.insert("operator-=", "__isub__");
-        operatorsHash.insert("operator*", "__mul__");
-        operatorsHash.insert("operator*=", "__imul__");
-        operatorsHash.insert("operator/", "__div__");
-        operatorsHash.insert("operator/=", "__idiv__");
-        operatorsHash.insert("operator%", "__mod__");
-        operatorsHash.insert("operator%=", "__imod__");
-        operatorsHash.insert("operator<<", "__lshift__");
-        operatorsHash.insert("operator<<=", "__ilshift__");
-        operatorsHash.insert("operator>>", "__rshift__");
-        operatorsHash.insert("operator>>=", "__irshift__");
-        operatorsHash.insert("operator&", "__and__");
-        operatorsHash.insert("operator&=", "__iand__");
-        operatorsHash.insert("operator|", "__or__");
-        operatorsHash.insert("operator|=", "__ior__");
-        operatorsHash.insert("operator^", "__xor__");
-        operatorsHash.insert("operator^=", "__ixor__");
-        operatorsHash.insert("operator==", "__eq__");
-        operatorsHash.insert("operator!=", "__ne__");
-        operatorsHash.insert("operator<", "__lt__");
-        operatorsHash.insert("operator<=", "__le__");
-        operatorsHash.insert("operator>", "__gt__");
-        operatorsHash.insert("operator>=", "__ge__");
-        hashInitialized = true;
-    }
+static QHash<QString, QString> createOperatorsHash()
+{
+    QHash<QString, QString> operatorsHash;
+    operatorsHash.insert("operator+", "__add__");
+    operatorsHash.insert("operator+=", "__iadd__");
+    operatorsHash.insert("operator-", "__sub__");
+    operatorsHash.insert("operator-=", "__isub__");
+    operatorsHash.insert("operator*", "__mul__");
+    operatorsHash.insert("operator*=", "__imul__");
+    operatorsHash.insert("operator/", "__div__");
+    operatorsHash.insert("operator/=", "__idiv__");
+    operatorsHash.insert("operator%", "__mod__");
+    operatorsHash.insert("operator%=", "__imod__");
+    operatorsHash.insert("operator<<", "__lshift__");
+    operatorsHash.insert("operator<<=", "__ilshift__");
+    operatorsHash.insert("operator>>", "__rshift__");
+    operatorsHash.insert("operator>>=", "__irshift__");
+    operatorsHash.insert("operator&", "__and__");
+    operatorsHash.insert("operator&=", "__iand__");
+    operatorsHash.insert("operator|", "__or__");
+    operatorsHash.insert("operator|=", "__ior__");
+    operatorsHash.insert("operator^", "__xor__");
+    operatorsHash.insert("operator^=", "__ixor__");
+    operatorsHash.insert("operator==", "__eq__");
+    operatorsHash.insert("operator!=", "__ne__");
+    operatorsHash.insert("operator<", "__lt__");
+    operatorsHash.insert("operator<=", "__le__");
+    operatorsHash.insert("operator>", "__gt__");
+    operatorsHash.insert("operator>=", "__ge__");
+    return operatorsHash;
+}
 
+static QString getFuncName(const AbstractMetaFunction* cppFunc) {
+    static const QHash<QString, QString> operatorsHash = createOperatorsHash();
     QHash<QString, QString>::const_iterator it = operatorsHash.find(cppFunc->name());
     QString result = it != operatorsHash.end() ? it.value() : cppFunc->name();
     return result.replace("::", ".");
 }
 
-QtDocGenerator::QtDocGenerator() : m_docParser(0)
+QtDocGenerator::QtDocGenerator()
+    : m_jobs(0), m_classesGenerated(false), m_codeSnippetMutex(QMutex::Recursive), m_docParser(0)
 {
 }
 
@@ -963,6 +939,169 @@ QtDocGenerator::~QtDocGenerator()
     delete m_docParser;
 }
 
+CodeSnippetFile QtDocGenerator::codeSnippetFile(const QString& location)
+{
+    QMutexLocker locker(&m_codeSnippetMutex);
+    QHash<QString, CodeSnippetFile>::const_iterator it = m_codeSnippetFiles.find(location);
+    if (it != m_codeSnippetFiles.end())
+        return it.value();
+
+    CodeSnippetFile& snippetFile = m_codeSnippetFiles[location];
+    QFile inputFile(location);
+    snippetFile.isValid = inputFile.open(QIODevice::ReadOnly);
+    if (!snippetFile.isValid)
+        return snippetFile;
+
+    // A snippet goes from the first line with its marker to the next one, other
+    // snippet markers found in between are removed from its code.
+    QRegExp snippetMarker("//!\\s*\\[([^\\]]+)\\]");
+    QRegExp codeSnippetCode("//!\\s*\\[[\\w\\d\\s]+\\]");
+    QSet<QString> openSnippets;
+    while (!inputFile.atEnd()) {
+        QString line = inputFile.readLine();
+        snippetFile.contents += line;
+
+        QStringList identifiers;
+        int pos = 0;
+        while ((pos = snippetMarker.indexIn(line, pos)) != -1) {
+            identifiers << snippetMarker.cap(1);
+            pos += snippetMarker.matchedLength();
+        }
+
+        if (!openSnippets.isEmpty()) {
+            QString code = QString(line).replace(codeSnippetCode, "");
+            foreach (QString identifier, openSnippets) {
+                if (!identifiers.contains(identifier))
+                    snippetFile.snippets[identifier] += code;
+            }
+        }
+
+        foreach (QString identifier, identifiers) {
+            if (openSnippets.remove(identifier))
+                continue;
+            // Only the first block of each identifier is used.
+            if (!snippetFile.snippets.contains(identifier)) {
+                snippetFile.snippets.insert(identifier, QString());
+                openSnippets.insert(identifier);
+            }
+        }
+    }
+    return snippetFile;
+}
+
+QString QtDocGenerator::resolveCodeSnippetPath(const QString& path)
+{
+    QMutexLocker locker(&m_codeSnippetMutex);
+    QHash<QString, QString>::const_iterator it = m_codeSnippetPaths.find(path);
+    if (it != m_codeSnippetPaths.end())
+        return it.value();
+
+    QString resolved;
+    foreach (QString location, m_codeSnippetDirs) {
+        location.append('/');
+        location.append(path);
+        if (codeSnippetFile(location).isValid) {
+            resolved = location;
+            break;
+        }
+    }
+    m_codeSnippetPaths.insert(path, resolved);
+    return resolved;
+}
+
+QString QtDocGenerator::transformDocumentation(const QString& doc, const QString& context)
+{
+    if (m_docCacheDir.isEmpty())
+        return QtXmlToSphinx(this, doc, context).result();
+
+    // The conversion output also depends on the indentation where it is written.
+    QByteArray key = QCryptographicHash::hash((QString::number(indentor().indent) + '\n' + context + '\n' + doc).toUtf8(),
+                                              QCryptographicHash::Sha1);
+    {
+        QMutexLocker locker(&m_sphinxCacheMutex);
+        QHash<QByteArray, SphinxCacheEntry>::const_iterator it = m_sphinxCache.find(key);
+        if (it != m_sphinxCache.end()) {
+            bool upToDate = true;
+            for (int i = 0; i < it->files.size() && upToDate; ++i)
+                upToDate = QFileInfo(it->files[i]).lastModified() == it->modified[i];
+            if (upToDate) {
+                m_usedSphinxCacheEntries.insert(key);
+                return it->result;
+            }
+        }
+    }
+
+    QtXmlToSphinx x(this, doc, context);
+    SphinxCacheEntry entry;
+    entry.result = x.result();
+    entry.files = x.codeFiles();
+    entry.files.removeDuplicates();
+    foreach (QString file, entry.files)
+        entry.modified << QFileInfo(file).lastModified();
+
+    QMutexLocker locker(&m_sphinxCacheMutex);
+    m_sphinxCache.insert(key, entry);
+    m_usedSphinxCacheEntries.insert(key);
+    return entry.result;
+}
+
+// Bump whenever the conversion of documentation to reStructuredText changes.
+static const quint32 SPHINX_CACHE_VERSION = 1;
+
+QString QtDocGenerator::sphinxCacheFileName() const
+{
+    return m_docCacheDir + '/' + packageName() + ".sphinx.cache";
+}
+
+void QtDocGenerator::loadSphinxCache()
+{
+    QFile file(sphinxCacheFileName());
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_4_5);
+    quint32 version;
+    QByteArray stamp;
+    in >> version >> stamp;
+    // The cache is useless if the classes the links point to changed.
+    if (version != SPHINX_CACHE_VERSION || stamp != m_sphinxCacheStamp)
+        return;
+
+    qint32 count;
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QByteArray key;
+        SphinxCacheEntry entry;
+        in >> key >> entry.result >> entry.files >> entry.modified;
+        m_sphinxCache.insert(key, entry);
+    }
+    if (in.status() != QDataStream::Ok)
+        m_sphinxCache.clear();
+}
+
+void QtDocGenerator::saveSphinxCache()
+{
+    if (m_docCacheDir.isEmpty())
+        return;
+
+    QDir().mkpath(m_docCacheDir);
+    QFile file(sphinxCacheFileName());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        ReportHandler::warning("Can't write documentation cache " + file.fileName());
+        return;
+    }
+
+    // Only conversions used by this run are kept, so the cache doesn't grow forever.
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_4_5);
+    out << SPHINX_CACHE_VERSION << m_sphinxCacheStamp << qint32(m_usedSphinxCacheEntries.size());
+    foreach (QByteArray key, m_usedSphinxCacheEntries) {
+        const SphinxCacheEntry& entry = m_sphinxCache[key];
+        out << key << entry.result << entry.files << entry.modified;
+    }
+}
+
 QString QtDocGenerator::fileNameForClass(const AbstractMetaClass* cppClass) const
 {
     return QString("%1.rst").arg(getClassTargetFullName(cppClass, false));
@@ -976,8 +1115,7 @@ void QtDocGenerator::writeFormatedText(QTextStream& s, const Documentation& doc,
         metaClassName = getClassTargetFullName(metaClass);
 
     if (doc.format() == Documentation::Native) {
-        QtXmlToSphinx x(this, doc.value(), metaClassName);
-        s << x;
+        s << transformDocumentation(doc.value(), metaClassName);
     } else {
         QStringList lines = doc.value().split("\n");
         QRegExp regex("\\S"); // non-space character
@@ -989,20 +1127,15 @@ void QtDocGenerator::writeFormatedText(QTextStream& s, const Documentation& doc,
                 typesystemIndentation = qMin(typesystemIndentation, idx);
         }
         foreach (QString line, lines)
-            s << INDENT << line.remove(0, typesystemIndentation) << endl;
+            s << indentor() << line.remove(0, typesystemIndentation) << endl;
     }
 
     s << endl;
 }
 
-static void writeInheritedByList(QTextStream& s, const AbstractMetaClass* metaClass, const AbstractMetaClassList& allClasses)
+void QtDocGenerator::writeInheritedByList(QTextStream& s, const AbstractMetaClass* metaClass)
 {
-    AbstractMetaClassList res;
-    foreach (AbstractMetaClass* c, allClasses) {
-        if (c != metaClass && c->inheritsFrom(metaClass))
-            res << c;
-    }
-
+    AbstractMetaClassList res = m_inheritedBy.value(metaClass);
     if (res.isEmpty())
         return;
 
@@ -1013,14 +1146,113 @@ static void writeInheritedByList(QTextStream& s, const AbstractMetaClass* metaCl
     s << classes.join(", ") << endl << endl;
 }
 
-void QtDocGenerator::generateClass(QTextStream& s, const AbstractMetaClass* metaClass)
+void QtDocGenerator::buildClassIndexes()
 {
-    ReportHandler::debugSparse("Generating Documentation for " + metaClass->fullName());
+    QCryptographicHash stamp(QCryptographicHash::Sha1);
+    stamp.addData(packageName().toUtf8());
+    foreach (AbstractMetaClass* metaClass, classes()) {
+        if (!m_classesByName.contains(metaClass->name()))
+            m_classesByName.insert(metaClass->name(), metaClass);
+        for (const AbstractMetaClass* base = metaClass->baseClass(); base; base = base->baseClass())
+            m_inheritedBy[base] << metaClass;
+
+        // Links in the converted documentation depend on the classes and where their methods are implemented.
+        stamp.addData(metaClass->typeEntry()->qualifiedTargetLangName().toUtf8());
+        foreach (const AbstractMetaFunction* func, metaClass->functions()) {
+            stamp.addData(func->name().toUtf8());
+            if (func->implementingClass())
+                stamp.addData(func->implementingClass()->name().toUtf8());
+        }
+    }
+    m_sphinxCacheStamp = stamp.result();
+}
+
+/**
+*   Runs QtDocGenerator::writeClass for one class, into its own buffer.
+*/
+struct ClassDocumentationWriter
+{
+    typedef void result_type;
+
+    ClassDocumentationWriter(QtDocGenerator* generator) : generator(generator) {}
+
+    void operator()(QPair<const AbstractMetaClass*, QString>& job)
+    {
+        QTextStream s(&job.second);
+        generator->writeClass(s, job.first);
+    }
 
-    m_packages[metaClass->package()] << fileNameForClass(metaClass);
+    QtDocGenerator* generator;
+};
 
-    m_docParser->setPackageName(metaClass->package());
-    m_docParser->fillDocumentation(const_cast<AbstractMetaClass*>(metaClass));
+static void fillLazyStrings(const AbstractMetaType* type)
+{
+    if (!type)
+        return;
+    type->name();
+    type->cppSignature();
+}
+
+// Computes the strings \p func caches on first use, they would be written from several threads otherwise.
+static void fillLazyStrings(const AbstractMetaFunction* func)
+{
+    func->minimalSignature();
+    func->signature();
+    func->modifiedName();
+    fillLazyStrings(func->type());
+    foreach (const AbstractMetaArgument* arg, func->arguments())
+        fillLazyStrings(arg->type());
+}
+
+void QtDocGenerator::generateAllClasses()
+{
+    m_classesGenerated = true;
+
+    QList<QPair<const AbstractMetaClass*, QString> > jobs;
+    foreach (AbstractMetaClass* metaClass, classes()) {
+        if (!shouldGenerate(metaClass) || fileNameForClass(metaClass).isNull())
+            continue;
+
+        m_packages[metaClass->package()] << fileNameForClass(metaClass);
+
+        // The documentation parser isn't thread safe, fill everything before going parallel.
+        m_docParser->setPackageName(metaClass->package());
+        m_docParser->fillDocumentation(metaClass);
+        // The writers only read the modification caches, see AbstractMetaFunction::setModificationCachesFrozen,
+        // and the other strings the meta objects compute on first use.
+        foreach (const AbstractMetaFunction* func, metaClass->functions()) {
+            func->fillModificationCache(metaClass);
+            fillLazyStrings(func);
+        }
+        jobs << qMakePair(static_cast<const AbstractMetaClass*>(metaClass), QString());
+    }
+
+    ClassDocumentationWriter writer(this);
+    if (m_jobs == 1) {
+        for (int i = 0; i < jobs.size(); ++i)
+            writer(jobs[i]);
+    } else {
+        if (m_jobs > 1)
+            QThreadPool::globalInstance()->setMaxThreadCount(m_jobs);
+        AbstractMetaFunction::setModificationCachesFrozen(true);
+        QtConcurrent::blockingMap(jobs, writer);
+        AbstractMetaFunction::setModificationCachesFrozen(false);
+    }
+
+    for (int i = 0; i < jobs.size(); ++i)
+        m_generatedClasses.insert(jobs[i].first, jobs[i].second);
+}
+
+void QtDocGenerator::generateClass(QTextStream& s, const AbstractMetaClass* metaClass)
+{
+    if (!m_classesGenerated)
+        generateAllClasses();
+    s << m_generatedClasses.take(metaClass);
+}
+
+void QtDocGenerator::writeClass(QTextStream& s, const AbstractMetaClass* metaClass)
+{
+    ReportHandler::debugSparse("Generating Documentation for " + metaClass->fullName());
 
     s << ".. module:: " << metaClass->package() << endl;
     QString className = getClassTargetFullName(metaClass, false);
@@ -1033,7 +1265,7 @@ void QtDocGenerator::generateClass(QTextStream& s, const AbstractMetaClass* meta
       << "    :parts: 2" << endl << endl; // TODO: This would be a parameter in the future...
 
 
-    writeInheritedByList(s, metaClass, classes());
+    writeInheritedByList(s, metaClass);
 
     if (metaClass->typeEntry() && (metaClass->typeEntry()->version() != 0))
         s << ".. note:: This class was introduced in Qt " << metaClass->typeEntry()->version() << endl;
@@ -1139,9 +1371,9 @@ void QtDocGenerator::writeFunctionBlock(QTextStream& s, const QString& title, QS
         qSort(functions);
 
         s << ".. container:: function_list" << endl << endl;
-        Indentation indentation(INDENT);
+        Indentation indentation(indentor());
         foreach (QString func, functions)
-            s << '*' << INDENT << func << endl;
+            s << '*' << indentor() << func << endl;
 
         s << endl << endl;
     }
@@ -1204,7 +1436,7 @@ void QtDocGenerator::writeConstructors(QTextStream& s, const AbstractMetaClass*
     s << endl;
 
     foreach (AbstractMetaArgument* arg, arg_map.values()) {
-        Indentation indentation(INDENT);
+        Indentation indentation(indentor());
         writeParamerteType(s, cppClass, arg);
     }
 
@@ -1262,7 +1494,7 @@ void QtDocGenerator::writeDocSnips(QTextStream &s,
                                  CodeSnip::Position position,
                                  TypeSystem::Language language)
 {
-    Indentation indentation(INDENT);
+    Indentation indentation(indentor());
     QStringList invalidStrings;
     const static QString startMarkup("[sphinx-begin]");
     const static QString endMarkup("[sphinx-end]");
@@ -1325,7 +1557,7 @@ bool QtDocGenerator::writeInjectDocumentation(QTextStream& s,
                                             const AbstractMetaClass* cppClass,
                                             const AbstractMetaFunction* func)
 {
-    Indentation indentation(INDENT);
+    Indentation indentation(indentor());
     bool didSomething = false;
 
     foreach (DocModification mod, cppClass->typeEntry()->docModifications()) {
@@ -1425,13 +1657,13 @@ QString QtDocGenerator::translateToPythonType(const AbstractMetaType* type, cons
 
 void QtDocGenerator::writeParamerteType(QTextStream& s, const AbstractMetaClass* cppClass, const AbstractMetaArgument* arg)
 {
-    s << INDENT << ":param " << arg->name() << ": "
+    s << indentor() << ":param " << arg->name() << ": "
       << translateToPythonType(arg->type(), cppClass) << endl;
 }
 
 void QtDocGenerator::writeFunctionParametersType(QTextStream& s, const AbstractMetaClass* cppClass, const AbstractMetaFunction* func)
 {
-    Indentation indentation(INDENT);
+    Indentation indentation(indentor());
 
     s << endl;
     foreach (AbstractMetaArgument* arg, func->arguments()) {
@@ -1457,7 +1689,7 @@ void QtDocGenerator::writeFunctionParametersType(QTextStream& s, const AbstractM
 
         if (retType.isEmpty())
             retType = translateToPythonType(func->type(), cppClass);
-        s << INDENT << ":rtype: " << retType << endl;
+        s << indentor() << ":rtype: " << retType << endl;
     }
     s << endl;
 }
@@ -1557,7 +1789,7 @@ void QtDocGenerator::finishGeneration()
         s << createRepeatedChar(title.length(), '*') << endl << endl;
 
         /* Avoid showing "Detailed Description for *every* class in toc tree */
-        Indentation indentation(INDENT);
+        Indentation indentation(indentor());
 
         // Search for extra-sections
         if (!m_extraSectionDir.isEmpty()) {
@@ -1580,14 +1812,14 @@ void QtDocGenerator::finishGeneration()
 
         writeFancyToc(s, it.value());
 
-        s << INDENT << ".. container:: hide" << endl << endl;
+        s << indentor() << ".. container:: hide" << endl << endl;
         {
-            Indentation indentation(INDENT);
-            s << INDENT << ".. toctree::" << endl;
-            Indentation deeperIndentation(INDENT);
-            s << INDENT << ":maxdepth: 1" << endl << endl;
+            Indentation indentation(indentor());
+            s << indentor() << ".. toctree::" << endl;
+            Indentation deeperIndentation(indentor());
+            s << indentor() << ":maxdepth: 1" << endl << endl;
             foreach (QString className, it.value())
-                s << INDENT << className << endl;
+                s << indentor() << className << endl;
             s << endl << endl;
         }
 
@@ -1603,13 +1835,14 @@ void QtDocGenerator::finishGeneration()
             // try the normal way
             Documentation moduleDoc = m_docParser->retrieveModuleDocumentation(it.key());
             if (moduleDoc.format() == Documentation::Native) {
-                QtXmlToSphinx x(this, moduleDoc.value(), QString(it.key()).remove(0, it.key().lastIndexOf('.') + 1));
-                s << x;
+                s << transformDocumentation(moduleDoc.value(), QString(it.key()).remove(0, it.key().lastIndexOf('.') + 1));
             } else {
                 s << moduleDoc.value();
             }
         }
     }
+
+    saveSphinxCache();
 }
 
 bool QtDocGenerator::doSetup(const QMap<QString, QString>& args)
@@ -1623,8 +1856,19 @@ bool QtDocGenerator::doSetup(const QMap<QString, QString>& args)
 #endif
     m_codeSnippetDirs = args.value("documentation-code-snippets-dir", m_libSourceDir).split(PATH_SEP);
     m_extraSectionDir = args.value("documentation-extra-sections-dir");
+    m_docCacheDir = args.value("documentation-cache-dir");
+    m_jobs = args.value("documentation-jobs").toInt();
 
-    m_docParser = args.value("doc-parser") == "doxygen" ? reinterpret_cast<DocParser*>(new DoxygenParser) : reinterpret_cast<DocParser*>(new QtDocParser);
+    buildClassIndexes();
+    loadSphinxCache();
+
+    if (args.value("doc-parser") == "doxygen") {
+        DoxygenParser* doxygenParser = new DoxygenParser;
+        doxygenParser->setCacheDirectory(m_docCacheDir);
+        m_docParser = doxygenParser;
+    } else {
+        m_docParser = new QtDocParser;
+    }
     ReportHandler::warning("doc-parser: " + args.value("doc-parser"));
 
     if (m_libSourceDir.isEmpty() || m_docDataDir.isEmpty()) {
@@ -1647,6 +1891,8 @@ QMap<QString, QString> QtDocGenerator::options() const
     options.insert("documentation-data-dir", "Directory with XML files generated by documentation tool (qdoc3 or Doxygen)");
     options.insert("documentation-code-snippets-dir", "Directory used to search code snippets used by the documentation");
     options.insert("documentation-extra-sections-dir", "Directory used to search for extra documentation sections");
+    options.insert("documentation-cache-dir", "Directory used to cache parsed and converted documentation between runs");
+    options.insert("documentation-jobs", "Number of classes documented in parallel (defaults to the number of CPUs)");
     return options;
 }
 
@@ -24,7 +24,10 @@
 #define DOCGENERATOR_H
 
 #include <QtCore/QStack>
+#include <QtCore/QDateTime>
 #include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QSet>
 #include <QtCore/QTextStream>
 #include <QXmlStreamReader>
 #include <abstractmetalang.h>
@@ -37,6 +40,19 @@ class AbstractMetaClass;
 class QXmlStreamReader;
 class QtDocGenerator;
 
+/**
+*   Contents of a code snippet file, with the blocks enclosed by "//! [identifier]"
+*   markers indexed by their identifiers.
+*/
+struct CodeSnippetFile
+{
+    CodeSnippetFile() : isValid(false) {}
+
+    bool isValid;
+    QString contents;
+    QHash<QString, QString> snippets;
+};
+
 class QtXmlToSphinx
 {
 public:
@@ -92,6 +108,12 @@ public:
         return m_result;
     }
 
+    /// Code snippet files read, or looked for, while converting the documentation.
+    QStringList codeFiles() const
+    {
+        return m_codeFiles;
+    }
+
 private:
     QString resolveContextForMethod(const QString& methodName);
     QString expandFunction(const QString& function);
@@ -142,9 +164,18 @@ private:
     bool m_insideItalic;
     QString m_lastTagName;
     QString m_opened_anchor;
-
-    QString readFromLocations(const QStringList& locations, const QString& path, const QString& identifier);
-    QString readFromLocation(const QString& location, const QString& identifier, bool* ok = 0);
+    QString m_heading;
+    char m_headingType;
+    QString m_listType;
+    QString m_linkTag;
+    QString m_linkRef;
+    QString m_linkText;
+    QString m_linkTagEnding;
+    QString m_linkType;
+    QStringList m_codeFiles;
+
+    QString readFromLocations(const QString& path, const QString& identifier);
+    QString readFromLocation(const QString& location, const QString& identifier);
     void pushOutputBuffer();
     QString popOutputBuffer();
     void writeTable(Table& table);
@@ -185,6 +216,31 @@ public:
         return m_codeSnippetDirs;
     }
 
+    /**
+    *   Returns the code snippet file at \p location. Each file is read and split
+    *   in snippets only once, later calls return the cached contents.
+    */
+    CodeSnippetFile codeSnippetFile(const QString& location);
+
+    /**
+    *   Returns the location of the first code snippet file found for \p path
+    *   in the code snippet directories, or an empty string if there is none.
+    */
+    QString resolveCodeSnippetPath(const QString& path);
+
+    /// Returns the first class named \p name, without scope, or null if there is none.
+    const AbstractMetaClass* findClassByName(const QString& name) const
+    {
+        return m_classesByName.value(name);
+    }
+
+    /**
+    *   Converts the WebXML or Doxygen documentation \p doc to reStructuredText.
+    *   When a documentation cache directory is set, conversions done by previous
+    *   runs are reused while the code snippet files they read stay unchanged.
+    */
+    QString transformDocumentation(const QString& doc, const QString& context);
+
 protected:
     QString fileNameForClass(const AbstractMetaClass* cppClass) const;
     void generateClass(QTextStream& s, const AbstractMetaClass* metaClass);
@@ -194,6 +250,22 @@ protected:
     void writeArgumentNames(QTextStream&, const AbstractMetaFunction*, Options) const {}
 
 private:
+    struct SphinxCacheEntry
+    {
+        QString result;
+        QStringList files;
+        QList<QDateTime> modified;
+    };
+    friend struct ClassDocumentationWriter;
+
+    void buildClassIndexes();
+    void generateAllClasses();
+    void writeClass(QTextStream& s, const AbstractMetaClass* metaClass);
+    void writeInheritedByList(QTextStream& s, const AbstractMetaClass* metaClass);
+    QString sphinxCacheFileName() const;
+    void loadSphinxCache();
+    void saveSphinxCache();
+
     void writeEnums(QTextStream& s, const AbstractMetaClass* cppClass);
 
     void writeFields(QTextStream &s, const AbstractMetaClass *cppClass);
@@ -217,6 +289,19 @@ private:
     QString m_docDataDir;
     QString m_libSourceDir;
     QStringList m_codeSnippetDirs;
+    QString m_docCacheDir;
+    int m_jobs;
+    QHash<QString, const AbstractMetaClass*> m_classesByName;
+    QHash<const AbstractMetaClass*, AbstractMetaClassList> m_inheritedBy;
+    QHash<const AbstractMetaClass*, QString> m_generatedClasses;
+    bool m_classesGenerated;
+    QMutex m_codeSnippetMutex;
+    QHash<QString, CodeSnippetFile> m_codeSnippetFiles;
+    QHash<QString, QString> m_codeSnippetPaths;
+    QMutex m_sphinxCacheMutex;
+    QByteArray m_sphinxCacheStamp;
+    QHash<QByteArray, SphinxCacheEntry> m_sphinxCache;
+    QSet<QByteArray> m_usedSphinxCacheEntries;
     QString m_extraSectionDir;
     QStringList m_functionList;
     QMap<QString, QStringList> m_packages;
@@ -473,6 +473,8 @@ void CppGenerator::writeDestructorNative(QTextStream &s, const AbstractMetaClass
 {
     Indentation indentation(INDENT);
     s << wrapperName(metaClass) << "::~" << wrapperName(metaClass) << "()" << endl << '{' << endl;
+    // The C++ object can be deleted by a thread that doesn't hold the GIL, which the binding manager needs.
+    s << INDENT << "Shiboken::GilState gil;" << endl;
     // kill pyobject
     s << INDENT << "SbkObject* wrapper = Shiboken::BindingManager::instance().retrieveWrapper(this);" << endl;
     s << INDENT << "Shiboken::Object::destroy(wrapper, this);" << endl;
@@ -585,8 +587,25 @@ void CppGenerator::writeVirtualMethodNative(QTextStream&s, const AbstractMetaFun
         s << INDENT << "return " << defaultReturnExpr << ';' << endl;
     }
 
+    int overrideCacheIndex = overrideCachedFunctions(func->ownerClass()).indexOf(const_cast<AbstractMetaFunction*>(func));
+    if (overrideCacheIndex != -1) {
+        // Known not to be overridden in Python: skip the lookup and call the C++ implementation.
+        s << INDENT << "if (m_overrideCache.isNotOverridden(" << overrideCacheIndex << ")) {" << endl;
+        {
+            Indentation indentation(INDENT);
+            s << INDENT << "gil.release();" << endl;
+            s << INDENT << "return this->::" << func->implementingClass()->qualifiedCppName() << "::";
+            writeFunctionCall(s, func, Generator::VirtualCall);
+            s << ';' << endl;
+        }
+        s << INDENT << '}' << endl;
+    }
+
     s << INDENT << "Shiboken::AutoDecRef " PYTHON_OVERRIDE_VAR "(Shiboken::BindingManager::instance().getOverride(this, \"";
-    s << funcName << "\"));" << endl;
+    s << funcName << '"';
+    if (overrideCacheIndex != -1)
+        s << ", &m_overrideCache, " << overrideCacheIndex;
+    s << "));" << endl;
 
     s << INDENT << "if (" PYTHON_OVERRIDE_VAR ".isNull()) {" << endl;
     {
@@ -1006,8 +1025,29 @@ void CppGenerator::writeConverterFunctions(QTextStream& s, const AbstractMetaCla
     sourceTypeName = QString("%1_COPY").arg(metaClass->name());
     targetTypeName = metaClass->name();
     code.clear();
-    c << INDENT << "return Shiboken::Object::newObject(&" << cpythonType << ", new ::" << wrapperName(metaClass);
-    c << "(*((" << typeName << "*)cppIn)), true, true);";
+    bool useCopyCache = metaClass->typeEntry()->typeFlags() & ComplexTypeEntry::CopyCache;
+    if (useCopyCache && shouldGenerateCppWrapper(metaClass)) {
+        // Wrapped copies carry a virtual table and can't be compared byte by byte.
+        ReportHandler::warning(QString("copy-cache ignored for value type '%1', which has a C++ wrapper class.")
+                               .arg(metaClass->qualifiedCppName()));
+        useCopyCache = false;
+    }
+    if (useCopyCache) {
+        c << INDENT << "PyObject* pyOut = Shiboken::ObjectType::findCachedCopy(&" << cpythonType;
+        c << ", cppIn, sizeof(" << typeName << "));" << endl;
+        c << INDENT << "if (pyOut)" << endl;
+        {
+            Indentation indent(INDENT);
+            c << INDENT << "return pyOut;" << endl;
+        }
+        c << INDENT << "pyOut = Shiboken::Object::newObject(&" << cpythonType << ", new ::" << wrapperName(metaClass);
+        c << "(*((" << typeName << "*)cppIn)), true, true);" << endl;
+        c << INDENT << "Shiboken::ObjectType::cacheCopy(&" << cpythonType << ", pyOut, sizeof(" << typeName << "));" << endl;
+        c << INDENT << "return pyOut;";
+    } else {
+        c << INDENT << "return Shiboken::Object::newObject(&" << cpythonType << ", new ::" << wrapperName(metaClass);
+        c << "(*((" << typeName << "*)cppIn)), true, true);";
+    }
     writeCppToPythonFunction(s, code, sourceTypeName, targetTypeName);
     s << endl;
 
@@ -1144,15 +1184,7 @@ void CppGenerator::writeConverterRegister(QTextStream& s, const AbstractMetaClas
 
     s << endl;
 
-    QStringList cppSignature = metaClass->qualifiedCppName().split("::", QString::SkipEmptyParts);
-    while (!cppSignature.isEmpty()) {
-        QString signature = cppSignature.join("::");
-        s << INDENT << "Shiboken::Conversions::registerConverterName(converter, \"" << signature << "\");" << endl;
-        s << INDENT << "Shiboken::Conversions::registerConverterName(converter, \"" << signature << "*\");" << endl;
-        s << INDENT << "Shiboken::Conversions::registerConverterName(converter, \"" << signature << "&\");" << endl;
-        cppSignature.removeFirst();
-    }
-
+    // The names of the type are in the module's converter names table, see addConverterNames().
     s << INDENT << "Shiboken::Conversions::registerConverterName(converter, typeid(::";
     s << metaClass->qualifiedCppName() << ").name());" << endl;
     if (shouldGenerateCppWrapper(metaClass)) {
@@ -1647,14 +1679,14 @@ void CppGenerator::writeCppSelfDefinition(QTextStream& s, const AbstractMetaClas
                                 .arg(className)
                                 .arg(CPP_SELF_VAR)
                                 .arg(cast)
-                                .arg(cpythonWrapperCPtr(metaClass, PYTHON_SELF_VAR));
+                                .arg(cpythonWrapperSelfCPtr(metaClass, PYTHON_SELF_VAR));
     } else {
         s << INDENT << className << "* " CPP_SELF_VAR " = 0;" << endl;
         writeUnusedVariableCast(s, CPP_SELF_VAR);
         cppSelfAttribution = QString("%1 = %2%3")
                                 .arg(CPP_SELF_VAR)
                                 .arg(useWrapperClass ? QString("(%1*)").arg(className) : "")
-                                .arg(cpythonWrapperCPtr(metaClass, PYTHON_SELF_VAR));
+                                .arg(cpythonWrapperSelfCPtr(metaClass, PYTHON_SELF_VAR));
     }
 
     // Checks if the underlying C++ object is valid.
@@ -2421,14 +2453,124 @@ void CppGenerator::writeCppToPythonFunction(QTextStream& s, const AbstractMetaTy
         writeCppToPythonFunction(s, customConversion);
         return;
     }
-    QString code = customConversion->nativeToTargetConversion();
-    for (int i = 0; i < containerType->instantiations().count(); ++i)
-        code.replace(QString("%INTYPE_%1").arg(i), getFullTypeName(containerType->instantiations().at(i)));
+    QString code;
+    if (static_cast<const ContainerTypeEntry*>(containerType->typeEntry())->returnsView())
+        code = containerViewConversion(containerType);
+    if (code.isEmpty()) {
+        code = customConversion->nativeToTargetConversion();
+        for (int i = 0; i < containerType->instantiations().count(); ++i)
+            code.replace(QString("%INTYPE_%1").arg(i), getFullTypeName(containerType->instantiations().at(i)));
+    } else {
+        code.prepend("PyObject* %out;\n");
+        code.append("return %out;\n");
+    }
     replaceCppToPythonVariables(code, getFullTypeNameWithoutModifiers(containerType));
     processCodeSnip(code);
     writeCppToPythonFunction(s, code, fixedCppTypeName(containerType));
 }
 
+// Returns the name of the view type, SbkSequenceView or SbkMappingView, for the containers that can be viewed.
+static QString containerViewKind(const ContainerTypeEntry* type)
+{
+    switch (type->type()) {
+        case ContainerTypeEntry::StackContainer:
+        case ContainerTypeEntry::QueueContainer:
+            // std::stack and std::queue are adaptors without iterators.
+            if (type->qualifiedCppName().startsWith("std::"))
+                break;
+            // fall through
+        case ContainerTypeEntry::ListContainer:
+        case ContainerTypeEntry::LinkedListContainer:
+        case ContainerTypeEntry::VectorContainer:
+        case ContainerTypeEntry::SetContainer:
+            return "SbkSequenceView";
+        case ContainerTypeEntry::MapContainer:
+        case ContainerTypeEntry::HashContainer:
+            return "SbkMappingView";
+        default:
+            break;
+    }
+    return QString();
+}
+
+// Returns true if the elements of a container type, or of the containers it holds, are pointers or
+// object types. The copy held by a view would not keep the pointed objects alive.
+static bool containerHoldsPointers(const AbstractMetaType* containerType)
+{
+    foreach (const AbstractMetaType* instantiation, containerType->instantiations()) {
+        if (instantiation->isObject() || instantiation->isNativePointer() || instantiation->indirections())
+            return true;
+        if (instantiation->isContainer() && containerHoldsPointers(instantiation))
+            return true;
+    }
+    return false;
+}
+
+// Returns the view type name for a container type instantiation, or an empty string if it can not be viewed.
+static QString containerViewKind(const AbstractMetaType* containerType)
+{
+    if (containerHoldsPointers(containerType))
+        return QString();
+    return containerViewKind(static_cast<const ContainerTypeEntry*>(containerType->typeEntry()));
+}
+
+QString CppGenerator::containerViewConversion(const AbstractMetaType* containerType)
+{
+    const ContainerTypeEntry* type = static_cast<const ContainerTypeEntry*>(containerType->typeEntry());
+    QString viewKind = containerViewKind(containerType);
+    if (viewKind.isEmpty()) {
+        QString reason = containerHoldsPointers(containerType) ? "it holds pointers or object types" : "it has no iterators";
+        ReportHandler::warning(QString("Container type '%1' can not be returned as a view, %2; it will be converted instead.")
+                                   .arg(containerType->cppSignature()).arg(reason));
+        return QString();
+    }
+    // Qt containers iterators have key() and value(), the ones from STL and the classes
+    // deriving from STL containers point to std::pair.
+    bool stdContainer = !type->qualifiedCppName().startsWith('Q');
+    QString code;
+    QTextStream c(&code);
+    if (viewKind == "SbkSequenceView") {
+        c << "struct SbkContainerView_" << endl;
+        c << "{" << endl;
+        c << "    static PyObject* itemToPython(const %INTYPE::const_iterator& it)" << endl;
+        c << "    {" << endl;
+        c << "        %INTYPE_0 cppItem(*it);" << endl;
+        c << "        return %CONVERTTOPYTHON[%INTYPE_0](cppItem);" << endl;
+        c << "    }" << endl;
+        c << "};" << endl;
+        c << "%out = Shiboken::Container::newSequenceView(%in, SbkContainerView_::itemToPython);" << endl;
+    } else {
+        c << "struct SbkContainerView_" << endl;
+        c << "{" << endl;
+        c << "    static PyObject* keyToPython(const %INTYPE::const_iterator& it)" << endl;
+        c << "    {" << endl;
+        c << "        %INTYPE_0 cppKey(" << (stdContainer ? "it->first" : "it.key()") << ");" << endl;
+        c << "        return %CONVERTTOPYTHON[%INTYPE_0](cppKey);" << endl;
+        c << "    }" << endl;
+        c << "    static PyObject* lookup(const %INTYPE& cppContainer, PyObject* pyKey)" << endl;
+        c << "    {" << endl;
+        c << "        if (!%ISCONVERTIBLE[%INTYPE_0](pyKey)) {" << endl;
+        c << "            PyErr_SetObject(PyExc_KeyError, pyKey);" << endl;
+        c << "            return 0;" << endl;
+        c << "        }" << endl;
+        c << "        %INTYPE_0 cppKey = %CONVERTTOCPP[%INTYPE_0](pyKey);" << endl;
+        c << "        %INTYPE::const_iterator it = cppContainer.find(cppKey);" << endl;
+        c << "        if (it == cppContainer.end()) {" << endl;
+        c << "            PyErr_SetObject(PyExc_KeyError, pyKey);" << endl;
+        c << "            return 0;" << endl;
+        c << "        }" << endl;
+        c << "        %INTYPE_1 cppValue(" << (stdContainer ? "it->second" : "it.value()") << ");" << endl;
+        c << "        return %CONVERTTOPYTHON[%INTYPE_1](cppValue);" << endl;
+        c << "    }" << endl;
+        c << "};" << endl;
+        c << "%out = Shiboken::Container::newMappingView(%in, SbkContainerView_::keyToPython, SbkContainerView_::lookup);" << endl;
+    }
+    for (int i = 0; i < containerType->instantiations().count(); ++i)
+        code.replace(QString("%INTYPE_%1").arg(i), getFullTypeName(containerType->instantiations().at(i)));
+    code.replace("%INTYPE", getFullTypeNameWithoutModifiers(containerType));
+    return code;
+}
+
 void CppGenerator::writePythonToCppFunction(QTextStream& s, const QString& code, const QString& sourceTypeName, const QString& targetTypeName)
 {
     QString prettyCode;
@@ -2599,6 +2741,15 @@ void CppGenerator::writePythonToCppConversionFunctions(QTextStream& s, const Abs
         typeCheck = QString("%1pyIn)").arg(typeCheck);
     writeIsPythonConvertibleToCppFunction(s, typeName, typeName, typeCheck);
     s << endl;
+
+    // Views given to Python are converted back by copying the container they hold.
+    QString viewKind = containerViewKind(containerType);
+    if (viewKind.isEmpty())
+        return;
+    QString viewedContainer = QString("Shiboken::Container::viewedContainer< %1 >(pyIn)").arg(cppTypeName);
+    writePythonToCppFunction(s, QString("*((%1*)cppOut) = *%2;").arg(cppTypeName).arg(viewedContainer), viewKind, typeName);
+    writeIsPythonConvertibleToCppFunction(s, viewKind, typeName, viewedContainer);
+    s << endl;
 }
 
 void CppGenerator::writeAddPythonToCppConversion(QTextStream& s, const QString& converterVar, const QString& pythonToCppFunc, const QString& isConvertibleFunc)
@@ -2687,6 +2838,24 @@ QString CppGenerator::argumentNameFromIndex(const AbstractMetaFunction* func, in
     return pyArgName;
 }
 
+// Returns true if the argument at \p argIndex (0 for the return value) is a container, whose
+// wrapped items can have their parent or ownership changed with a single libshiboken call.
+static bool isContainerArgument(const AbstractMetaFunction* func, int argIndex)
+{
+    if (argIndex < 0 || !func->typeReplaced(argIndex).isEmpty())
+        return false;
+    const AbstractMetaType* type = 0;
+    if (argIndex == 0) {
+        type = func->type();
+    } else {
+        int realIndex = argIndex - 1 - OverloadData::numberOfRemovedArguments(func, argIndex - 1);
+        if (realIndex < 0 || realIndex >= func->arguments().count())
+            return false;
+        type = func->arguments().at(realIndex)->type();
+    }
+    return type && type->isContainer();
+}
+
 void CppGenerator::writeMethodCall(QTextStream& s, const AbstractMetaFunction* func, int maxArgs)
 {
     s << INDENT << "// " << func->minimalSignature() << (func->isReverseOperator() ? " [reverse operator]": "") << endl;
@@ -2954,14 +3123,29 @@ void CppGenerator::writeMethodCall(QTextStream& s, const AbstractMetaFunction* f
                 writeConversionRule(s, func, TypeSystem::TargetLangCode, PYTHON_RETURN_VAR);
             } else if (!isCtor && !func->isInplaceOperator() && func->type()
                 && !injectedCodeHasReturnValueAttribution(func, TypeSystem::TargetLangCode)) {
-                s << INDENT << PYTHON_RETURN_VAR " = ";
-                if (isObjectTypeUsedAsValueType(func->type())) {
-                    s << "Shiboken::Object::newObject((SbkObjectType*)" << cpythonTypeNameExt(func->type()->typeEntry());
-                    s << ", " << CPP_RETURN_VAR << ", true, true)";
+                QString viewConversion;
+                if (func->returnsContainerView() && func->type()->isContainer() && !func->type()->indirections())
+                    viewConversion = containerViewConversion(func->type());
+                if (!viewConversion.isEmpty()) {
+                    viewConversion.replace("%in", CPP_RETURN_VAR);
+                    viewConversion.replace("%out", PYTHON_RETURN_VAR);
+                    processCodeSnip(viewConversion);
+                    s << INDENT << '{' << endl;
+                    {
+                        Indentation indent(INDENT);
+                        formatCode(s, viewConversion, INDENT);
+                    }
+                    s << INDENT << '}' << endl;
                 } else {
-                    writeToPythonConversion(s, func->type(), func->ownerClass(), CPP_RETURN_VAR);
+                    s << INDENT << PYTHON_RETURN_VAR " = ";
+                    if (isObjectTypeUsedAsValueType(func->type())) {
+                        s << "Shiboken::Object::newObject((SbkObjectType*)" << cpythonTypeNameExt(func->type()->typeEntry());
+                        s << ", " << CPP_RETURN_VAR << ", true, true)";
+                    } else {
+                        writeToPythonConversion(s, func->type(), func->ownerClass(), CPP_RETURN_VAR);
+                    }
+                    s << ';' << endl;
                 }
-                s << ';' << endl;
             }
         }
     }
@@ -3009,7 +3193,10 @@ void CppGenerator::writeMethodCall(QTextStream& s, const AbstractMetaFunction* f
                 continue;
 
             s << INDENT << "Shiboken::Object::";
-            if (arg_mod.ownerships[TypeSystem::TargetLangCode] == TypeSystem::TargetLangOwnership) {
+            bool toPython = arg_mod.ownerships[TypeSystem::TargetLangCode] == TypeSystem::TargetLangOwnership;
+            if (isContainerArgument(func, arg_mod.index) && (toPython || wrappedClass->hasVirtualDestructor())) {
+                s << "transferOwnershipMany(" << pyArgName << ", " << (toPython ? "true" : "false") << ");";
+            } else if (toPython) {
                 s << "getOwnership(" << pyArgName << ");";
             } else if (wrappedClass->hasVirtualDestructor()) {
                 if (arg_mod.index == 0)
@@ -3203,15 +3390,6 @@ void CppGenerator::writeEnumConverterInitialization(QTextStream& s, const TypeEn
 
         s << INDENT << "Shiboken::Enum::setTypeConverter(" << enumPythonType << ", converter);" << endl;
         s << INDENT << "Shiboken::Enum::setTypeConverter(" << enumPythonType << ", converter);" << endl;
-        QStringList cppSignature = enumType->qualifiedCppName().split("::", QString::SkipEmptyParts);
-        while (!cppSignature.isEmpty()) {
-            QString signature = cppSignature.join("::");
-            s << INDENT << "Shiboken::Conversions::registerConverterName(converter, \"";
-            if (flags)
-                s << "QFlags<";
-            s << signature << "\");" << endl;
-            cppSignature.removeFirst();
-        }
     }
     s << INDENT << '}' << endl;
 
@@ -3219,6 +3397,39 @@ void CppGenerator::writeEnumConverterInitialization(QTextStream& s, const TypeEn
         writeEnumConverterInitialization(s, reinterpret_cast<const EnumTypeEntry*>(enumType)->flags());
 }
 
+void CppGenerator::addConverterNames(QMap<QString, QString>& names, const AbstractMetaClass* metaClass)
+{
+    QString typeIndex = getTypeIndexVariableName(metaClass->typeEntry());
+    QStringList cppSignature = metaClass->qualifiedCppName().split("::", QString::SkipEmptyParts);
+    while (!cppSignature.isEmpty()) {
+        QString signature = cppSignature.join("::");
+        // The first type registering a name keeps it.
+        foreach (const QString& name, QStringList() << signature << signature + '*' << signature + '&') {
+            if (!names.contains(name))
+                names.insert(name, typeIndex);
+        }
+        cppSignature.removeFirst();
+    }
+}
+
+void CppGenerator::addConverterNames(QMap<QString, QString>& names, const TypeEntry* enumType)
+{
+    if (!enumType)
+        return;
+    QString typeIndex = getTypeIndexVariableName(enumType);
+    QStringList cppSignature = enumType->qualifiedCppName().split("::", QString::SkipEmptyParts);
+    while (!cppSignature.isEmpty()) {
+        QString name = cppSignature.join("::");
+        if (enumType->isFlags())
+            name.prepend("QFlags<");
+        if (!names.contains(name))
+            names.insert(name, typeIndex);
+        cppSignature.removeFirst();
+    }
+    if (!enumType->isFlags())
+        addConverterNames(names, reinterpret_cast<const EnumTypeEntry*>(enumType)->flags());
+}
+
 void CppGenerator::writeContainerConverterInitialization(QTextStream& s, const AbstractMetaType* type)
 {
     QByteArray cppSignature = QMetaObject::normalizedSignature(type->cppSignature().toAscii());
@@ -3243,6 +3454,12 @@ void CppGenerator::writeContainerConverterInitialization(QTextStream& s, const A
         cppSignature.remove(0, sizeof("const ") / sizeof(char) - 1);
         s << INDENT << "Shiboken::Conversions::registerConverterName(" << converter << ", \"" << cppSignature << "\");" << endl;
     }
+    // Views go first, copying the container they hold is cheaper than converting their items.
+    QString viewKind = containerViewKind(type);
+    if (!viewKind.isEmpty()) {
+        writeAddPythonToCppConversion(s, converterObject(type), pythonToCppFunctionName(viewKind, typeName),
+                                      convertibleToCppFunctionName(viewKind, typeName));
+    }
     writeAddPythonToCppConversion(s, converterObject(type), toCpp, isConv);
 }
 
@@ -3384,6 +3601,8 @@ void CppGenerator::writeClassDefinition(QTextStream& s, const AbstractMetaClass*
         && metaClass->hasToStringCapability()) {
         m_tpFuncs["__repr__"] = writeReprFunction(s, metaClass);
     }
+    if (m_tpFuncs["__iter__"] == "0" && usesStdListWrapperMethods(metaClass))
+        m_tpFuncs["__iter__"] = cpythonBaseName(metaClass->typeEntry()) + "__iter__";
 
     // class or some ancestor has multiple inheritance
     const AbstractMetaClass* miClass = getMultipleInheritingClass(metaClass);
@@ -3516,6 +3735,17 @@ void CppGenerator::writeSequenceMethods(QTextStream& s, const AbstractMetaClass*
         writeStdListWrapperMethods(s, metaClass);
 }
 
+bool CppGenerator::usesStdListWrapperMethods(const AbstractMetaClass* metaClass)
+{
+    if (!supportsSequenceProtocol(metaClass))
+        return false;
+    foreach (QString funcName, m_sequenceProtocol.keys()) {
+        if (metaClass->findFunction(funcName))
+            return false;
+    }
+    return true;
+}
+
 void CppGenerator::writeTypeAsSequenceDefinition(QTextStream& s, const AbstractMetaClass* metaClass)
 {
     bool hasFunctions = false;
@@ -3546,6 +3776,14 @@ void CppGenerator::writeTypeAsSequenceDefinition(QTextStream& s, const AbstractM
         if (m_sqFuncs[sqName] == "sq_slice")
             s << "#endif" << endl;
     }
+
+    // The default implementation also accepts slices as subscripts.
+    if (!hasFunctions) {
+        s << INDENT << "memset(&" << baseName << "_Type.super.as_mapping, 0, sizeof(PyMappingMethods));" << endl;
+        s << INDENT << baseName << "_Type.super.as_mapping.mp_length = " << baseName << "__len__;" << endl;
+        s << INDENT << baseName << "_Type.super.as_mapping.mp_subscript = " << baseName << "__subscript__;" << endl;
+        s << INDENT << baseName << "_Type.super.ht_type.tp_as_mapping = &" << baseName << "_Type.super.as_mapping;" << endl;
+    }
 }
 
 void CppGenerator::writeTypeAsMappingDefinition(QTextStream& s, const AbstractMetaClass* metaClass)
@@ -3976,11 +4214,11 @@ void CppGenerator::writeEnumInitialization(QTextStream& s, const AbstractMetaEnu
     if (!cppEnum->isAnonymous()) {
         FlagsTypeEntry* flags = cppEnum->typeEntry()->flags();
         if (flags) {
-            s << INDENT << cpythonTypeNameExt(flags) << " = PySide::QFlags::create(\"" << flags->flagsName() << "\", &"
+            s << INDENT << cpythonTypeSlot(flags) << " = PySide::QFlags::create(\"" << flags->flagsName() << "\", &"
               << cpythonEnumName(cppEnum) << "_as_number);" << endl;
         }
 
-        s << INDENT << cpythonTypeNameExt(cppEnum->typeEntry()) << " = Shiboken::Enum::";
+        s << INDENT << cpythonTypeSlot(cppEnum->typeEntry()) << " = Shiboken::Enum::";
         s << ((enclosingClass || hasUpperEnclosingClass) ? "createScopedEnum" : "createGlobalEnum");
         s << '(' << enclosingObjectVariable << ',' << endl;
         {
@@ -4261,7 +4499,7 @@ void CppGenerator::writeClassRegister(QTextStream& s, const AbstractMetaClass* m
         s << endl;
     }
 
-    s << INDENT << cpythonTypeNameExt(classTypeEntry);
+    s << INDENT << cpythonTypeSlot(classTypeEntry);
     s << " = reinterpret_cast<PyTypeObject*>(&" << pyTypeName << ");" << endl;
     s << endl;
 
@@ -4484,7 +4722,7 @@ void CppGenerator::writeSetattroFunction(QTextStream& s, const AbstractMetaClass
         Indentation indent(INDENT);
         s << INDENT << "return PySide::Property::setValue(reinterpret_cast<PySideProperty*>(pp.object()), " PYTHON_SELF_VAR ", value);" << endl;
     }
-    s << INDENT << "return PyObject_GenericSetAttr(" PYTHON_SELF_VAR ", name, value);" << endl;
+    s << INDENT << "return SbkObject_Type.super.ht_type.tp_setattro(" PYTHON_SELF_VAR ", name, value);" << endl;
     s << '}' << endl;
 }
 
@@ -4589,6 +4827,13 @@ void CppGenerator::finishGeneration()
         lst.insert(indexOf, klassQMetaObject);
     }
 
+    // With lazy type initialization every top-level class gets a function creating it together
+    // with its nested classes and enums, and each type index is mapped to one of these functions.
+    QList<const AbstractMetaClass*> lazyRoots;
+    QHash<const AbstractMetaClass*, QStringList> lazyInitBodies;
+    QString lazyTypeIndexes;
+    QTextStream s_lazyTypeIndexes(&lazyTypeIndexes);
+
     foreach (const AbstractMetaClass* cls, lst) {
         if (!shouldGenerate(cls))
             continue;
@@ -4601,7 +4846,36 @@ void CppGenerator::finishGeneration()
             defineStr += "(" + cpythonTypeNameExt(cls->enclosingClass()->typeEntry()) +"->tp_dict);";
         else
             defineStr += "(module);";
-        s_classPythonDefines << INDENT << defineStr << endl;
+
+        if (!useLazyTypeInit()) {
+            s_classPythonDefines << INDENT << defineStr << endl;
+            continue;
+        }
+
+        const AbstractMetaClass* root = cls;
+        while (root->enclosingClass() && root->enclosingClass()->typeEntry()->codeGeneration() != TypeEntry::GenerateForSubclass)
+            root = root->enclosingClass();
+        if (!lazyInitBodies.contains(root))
+            lazyRoots << root;
+        lazyInitBodies[root] << defineStr;
+
+        QString initIndex = QString::number(lazyRoots.indexOf(root));
+        s_lazyTypeIndexes << INDENT << "lazyTypeInitIndexes[" << getTypeIndexVariableName(cls->typeEntry()) << "] = " << initIndex << ';' << endl;
+        // typeid() names are not in the converter names table, looking one up must create its type.
+        if (!cls->isNamespace()) {
+            s_lazyTypeIndexes << INDENT << "Shiboken::Conversions::registerConverterName(" << cppApiVariableName() << ", ";
+            s_lazyTypeIndexes << getTypeIndexVariableName(cls->typeEntry()) << ", typeid(::" << cls->qualifiedCppName() << ").name());" << endl;
+        }
+        AbstractMetaEnumList classEnums = cls->enums();
+        foreach (AbstractMetaClass* innerClass, cls->innerClasses())
+            lookForEnumsInClassesNotToBeGenerated(classEnums, innerClass);
+        foreach (const AbstractMetaEnum* cppEnum, classEnums) {
+            if (cppEnum->isPrivate() || cppEnum->isAnonymous())
+                continue;
+            s_lazyTypeIndexes << INDENT << "lazyTypeInitIndexes[" << getTypeIndexVariableName(cppEnum->typeEntry()) << "] = " << initIndex << ';' << endl;
+            if (FlagsTypeEntry* flags = cppEnum->typeEntry()->flags())
+                s_lazyTypeIndexes << INDENT << "lazyTypeInitIndexes[" << getTypeIndexVariableName(flags) << "] = " << initIndex << ';' << endl;
+        }
     }
 
     QString moduleFileName(outputDirectory() + "/" + subDirectoryForPackage(packageName()));
@@ -4622,6 +4896,8 @@ void CppGenerator::finishGeneration()
     s << "#include <sbkpython.h>" << endl;
     s << "#include <shiboken.h>" << endl;
     s << "#include <algorithm>" << endl;
+    if (useLazyTypeInit())
+        s << "#include <typeinfo>" << endl;
     if (usePySideExtensions())
         s << "#include <pyside.h>" << endl;
 
@@ -4639,6 +4915,26 @@ void CppGenerator::finishGeneration()
         lookForEnumsInClassesNotToBeGenerated(globalEnums, metaClass);
     }
 
+    // Names of the converters of the module's wrapper types and enums, sorted by QMap.
+    QMap<QString, QString> converterNames;
+    foreach (const AbstractMetaClass* cls, lst) {
+        if (!shouldGenerate(cls))
+            continue;
+        if (!cls->isNamespace())
+            addConverterNames(converterNames, cls);
+        AbstractMetaEnumList classEnums = cls->enums();
+        foreach (AbstractMetaClass* innerClass, cls->innerClasses())
+            lookForEnumsInClassesNotToBeGenerated(classEnums, innerClass);
+        foreach (const AbstractMetaEnum* cppEnum, classEnums) {
+            if (!cppEnum->isPrivate() && !cppEnum->isAnonymous())
+                addConverterNames(converterNames, cppEnum->typeEntry());
+        }
+    }
+    foreach (const AbstractMetaEnum* cppEnum, globalEnums) {
+        if (!cppEnum->isPrivate() && !cppEnum->isAnonymous())
+            addConverterNames(converterNames, cppEnum->typeEntry());
+    }
+
     TypeDatabase* typeDb = TypeDatabase::instance();
     TypeSystemTypeEntry* moduleEntry = reinterpret_cast<TypeSystemTypeEntry*>(typeDb->findType(packageName()));
 
@@ -4699,6 +4995,24 @@ void CppGenerator::finishGeneration()
     s << "------------------------------------------------------------" << endl;
     s << classInitDecl << endl;
 
+    if (!lazyRoots.isEmpty()) {
+        s << "// Lazy classes initialization ";
+        s << "------------------------------------------------------------" << endl;
+        foreach (const AbstractMetaClass* root, lazyRoots) {
+            s << "static void lazyInit_" << root->qualifiedCppName().replace("::", "_") << "(PyObject* module)" << endl;
+            s << '{' << endl;
+            foreach (const QString& defineStr, lazyInitBodies[root])
+                s << INDENT << defineStr << endl;
+            s << '}' << endl << endl;
+        }
+        s << "static Shiboken::Module::LazyTypeInit lazyTypeInits[] = {" << endl;
+        foreach (const AbstractMetaClass* root, lazyRoots) {
+            s << INDENT << "{\"" << root->name() << "\", lazyInit_";
+            s << root->qualifiedCppName().replace("::", "_") << "}," << endl;
+        }
+        s << INDENT << "{0, 0} // Sentinel" << endl << "};" << endl << endl;
+    }
+
     if (!globalEnums.isEmpty()) {
         QString converterImpl;
         QTextStream convImpl(&converterImpl);
@@ -4721,6 +5035,14 @@ void CppGenerator::finishGeneration()
         }
     }
 
+    if (!converterNames.isEmpty()) {
+        s << "// Converter names of the module's types, sorted for binary search." << endl;
+        s << "static const Shiboken::Conversions::ConverterName converterNames[] = {" << endl;
+        for (QMap<QString, QString>::const_iterator it = converterNames.constBegin(); it != converterNames.constEnd(); ++it)
+            s << INDENT << "{\"" << it.key() << "\", " << it.value() << "}," << endl;
+        s << INDENT << "{0, 0} // Sentinel" << endl << "};" << endl << endl;
+    }
+
     QStringList requiredModules = typeDb->requiredTargetImports();
     if (!requiredModules.isEmpty())
         s << "// Required modules' type and converter arrays." << endl;
@@ -4806,7 +5128,8 @@ void CppGenerator::finishGeneration()
                 Indentation indentation(INDENT);
                 s << INDENT << "SBK_MODULE_INIT_ERROR;" << endl;
             }
-            s << INDENT << cppApiVariableName(requiredModule) << " = Shiboken::Module::getTypes(requiredModule);" << endl;
+            s << INDENT << cppApiVariableName(requiredModule) << " = Shiboken::Module::";
+            s << (useLazyTypeInit() ? "getLazyTypes" : "getTypes") << "(requiredModule);" << endl;
             s << INDENT << convertersVariableName(requiredModule) << " = Shiboken::Module::getTypeConverters(requiredModule);" << endl;
         }
         s << INDENT << "}" << endl << endl;
@@ -4833,8 +5156,20 @@ void CppGenerator::finishGeneration()
     //s << INDENT << "// Initialize converters for primitive types." << endl;
     //s << INDENT << "initConverters();" << endl << endl;
 
-    s << INDENT << "// Initialize classes in the type system" << endl;
-    s << classPythonDefines;
+    if (!converterNames.isEmpty())
+        s << INDENT << "Shiboken::Conversions::registerConverterNames(" << cppApiVariableName() << ", converterNames);" << endl << endl;
+
+    if (lazyRoots.isEmpty()) {
+        s << INDENT << "// Initialize classes in the type system" << endl;
+        s << classPythonDefines;
+    } else {
+        s << INDENT << "// Classes in the type system are initialized on their first use" << endl;
+        s << INDENT << "static int lazyTypeInitIndexes[SBK_" << moduleName() << "_IDX_COUNT];" << endl;
+        s << INDENT << "std::fill(lazyTypeInitIndexes, lazyTypeInitIndexes + SBK_" << moduleName() << "_IDX_COUNT, -1);" << endl;
+        s << lazyTypeIndexes;
+        s << INDENT << "Shiboken::Module::registerLazyTypes(module, " << cppApiVariableName() << ", SBK_";
+        s << moduleName() << "_IDX_COUNT, lazyTypeInits, lazyTypeInitIndexes);" << endl;
+    }
 
     if (!typeConversions.isEmpty()) {
         s << endl;
@@ -4986,7 +5321,8 @@ bool CppGenerator::writeParentChildManagement(QTextStream& s, const AbstractMeta
         else
             childVariable = usePyArgs ? QString(PYTHON_ARGS "[%1]").arg(QString::number(childIndex-1)) : PYTHON_ARG;
 
-        s << INDENT << "Shiboken::Object::setParent(" << parentVariable << ", " << childVariable << ");\n";
+        s << INDENT << "Shiboken::Object::" << (isContainerArgument(func, childIndex) ? "setParentMany(" : "setParent(");
+        s << parentVariable << ", " << childVariable << ");\n";
         return true;
     }
 
@@ -5052,8 +5388,9 @@ void CppGenerator::writeStdListWrapperMethods(QTextStream& s, const AbstractMeta
     writeCppSelfDefinition(s, metaClass);
     writeIndexError(s, "index out of bounds");
 
+    // std::advance takes constant time on random access containers.
     s << INDENT << metaClass->qualifiedCppName() << "::iterator _item = " CPP_SELF_VAR "->begin();" << endl;
-    s << INDENT << "for (Py_ssize_t pos = 0; pos < _i; pos++) _item++;" << endl;
+    s << INDENT << "std::advance(_item, _i);" << endl;
 
     const AbstractMetaType* itemType = metaClass->templateBaseClassInstantiations().first();
 
@@ -5083,10 +5420,106 @@ void CppGenerator::writeStdListWrapperMethods(QTextStream& s, const AbstractMeta
     writeArgumentConversion(s, itemType, "cppValue", "pyArg", metaClass);
 
     s << INDENT << metaClass->qualifiedCppName() << "::iterator _item = " CPP_SELF_VAR "->begin();" << endl;
-    s << INDENT << "for (Py_ssize_t pos = 0; pos < _i; pos++) _item++;" << endl;
+    s << INDENT << "std::advance(_item, _i);" << endl;
     s << INDENT << "*_item = cppValue;" << endl;
     s << INDENT << "return 0;" << endl;
     s << '}' << endl;
+
+    writeStdListSubscriptFunction(s, metaClass, itemType);
+    writeStdListIteratorFunctions(s, metaClass, itemType);
+}
+
+void CppGenerator::writeStdListSubscriptFunction(QTextStream& s, const AbstractMetaClass* metaClass, const AbstractMetaType* itemType)
+{
+    ErrorCode errorCode(0);
+    QString baseName = cpythonBaseName(metaClass->typeEntry());
+
+    // Integer subscripts go through the sequence protocol, slices produce a Python list.
+    s << "PyObject* " << baseName << "__subscript__(PyObject* " PYTHON_SELF_VAR ", PyObject* key)" << endl;
+    s << '{' << endl;
+    s << INDENT << "if (!PySlice_Check(key))" << endl;
+    {
+        Indentation indent(INDENT);
+        s << INDENT << "return Shiboken::Container::getIndexedItem(" PYTHON_SELF_VAR ", key);" << endl;
+    }
+    writeCppSelfDefinition(s, metaClass);
+    s << INDENT << "Py_ssize_t start, stop, step, sliceLength;" << endl;
+    s << INDENT << "if (!Shiboken::Container::sliceIndices(key, (Py_ssize_t) " CPP_SELF_VAR "->size(), &start, &stop, &step, &sliceLength))" << endl;
+    {
+        Indentation indent(INDENT);
+        s << INDENT << "return 0;" << endl;
+    }
+    s << INDENT << "PyObject* " PYTHON_RETURN_VAR " = PyList_New(sliceLength);" << endl;
+    s << INDENT << metaClass->qualifiedCppName() << "::iterator _item = " CPP_SELF_VAR "->begin();" << endl;
+    s << INDENT << "Py_ssize_t pos = 0;" << endl;
+    s << INDENT << "for (Py_ssize_t i = 0; " PYTHON_RETURN_VAR " && i < sliceLength; ++i, start += step) {" << endl;
+    {
+        Indentation indent(INDENT);
+        s << INDENT << "std::advance(_item, start - pos);" << endl;
+        s << INDENT << "pos = start;" << endl;
+        s << INDENT << "PyObject* pyItem = ";
+        writeToPythonConversion(s, itemType, metaClass, "*_item");
+        s << ';' << endl;
+        s << INDENT << "if (!pyItem)" << endl;
+        {
+            Indentation indent(INDENT);
+            s << INDENT << "Py_CLEAR(" PYTHON_RETURN_VAR ");" << endl;
+        }
+        s << INDENT << "else" << endl;
+        {
+            Indentation indent(INDENT);
+            s << INDENT << "PyList_SET_ITEM(" PYTHON_RETURN_VAR ", i, pyItem);" << endl;
+        }
+    }
+    s << INDENT << '}' << endl;
+    s << INDENT << "return " PYTHON_RETURN_VAR ";" << endl;
+    s << '}' << endl;
+}
+
+void CppGenerator::writeStdListIteratorFunctions(QTextStream& s, const AbstractMetaClass* metaClass, const AbstractMetaType* itemType)
+{
+    ErrorCode errorCode(0);
+    QString baseName = cpythonBaseName(metaClass->typeEntry());
+    QString stateName = baseName + "_IteratorState";
+
+    // Changes to the container size during the iteration are reported. Shiboken::Container::IteratorState
+    // looks random access items up again from begin() at every step and copies the other containers.
+    s << "typedef Shiboken::Container::IteratorState< " << metaClass->qualifiedCppName() << " > " << stateName << ';' << endl << endl;
+
+    s << "static void " << baseName << "__deleteIteratorState__(void* state)" << endl;
+    s << '{' << endl;
+    s << INDENT << "delete reinterpret_cast<" << stateName << "*>(state);" << endl;
+    s << '}' << endl << endl;
+
+    s << "static PyObject* " << baseName << "__next__(PyObject* " PYTHON_SELF_VAR ", void* iteratorState)" << endl;
+    s << '{' << endl;
+    writeCppSelfDefinition(s, metaClass);
+    s << INDENT << stateName << "* state = reinterpret_cast<" << stateName << "*>(iteratorState);" << endl;
+    s << INDENT << "if (state->sizeChanged(*" CPP_SELF_VAR ")) {" << endl;
+    {
+        Indentation indent(INDENT);
+        s << INDENT << "PyErr_SetString(PyExc_RuntimeError, \"container changed size during iteration\");" << endl;
+        s << INDENT << "return 0;" << endl;
+    }
+    s << INDENT << '}' << endl;
+    s << INDENT << stateName << "::ConstIterator item;" << endl;
+    s << INDENT << "if (!state->next(*" CPP_SELF_VAR ", item))" << endl;
+    {
+        Indentation indent(INDENT);
+        s << INDENT << "return 0;" << endl;
+    }
+    s << INDENT << "return ";
+    writeToPythonConversion(s, itemType, metaClass, "*item");
+    s << ';' << endl;
+    s << '}' << endl << endl;
+
+    s << "static PyObject* " << baseName << "__iter__(PyObject* " PYTHON_SELF_VAR ")" << endl;
+    s << '{' << endl;
+    writeCppSelfDefinition(s, metaClass);
+    s << INDENT << stateName << "* state = new " << stateName << "(*" CPP_SELF_VAR ");" << endl;
+    s << INDENT << "return Shiboken::Container::newIterator(" PYTHON_SELF_VAR ", state, " << baseName << "__next__, ";
+    s << baseName << "__deleteIteratorState__);" << endl;
+    s << '}' << endl;
 }
 void CppGenerator::writeIndexError(QTextStream& s, const QString& errorMsg)
 {
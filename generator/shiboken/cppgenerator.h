@@ -171,6 +171,14 @@ private:
     void writeCppToPythonFunction(QTextStream& s, const CustomConversion* customConversion);
     void writeCppToPythonFunction(QTextStream& s, const AbstractMetaType* containerType);
 
+    /**
+     *   Returns a C++ to Python conversion code snippet that gives Python a read-only view
+     *   of the container in "%in", assigned to "%out", instead of a list or dictionary.
+     *   The elements are converted only when accessed. Returns an empty string if the
+     *   container kind can not be viewed.
+     */
+    QString containerViewConversion(const AbstractMetaType* containerType);
+
     /// Writes a Python to C++ conversion function.
     void writePythonToCppFunction(QTextStream& s, const QString& code, const QString& sourceTypeName, const QString& targetTypeName);
 
@@ -254,6 +262,9 @@ private:
     void writeEnumConverterInitialization(QTextStream& s, const TypeEntry* enumType);
     void writeEnumConverterInitialization(QTextStream& s, const AbstractMetaEnum* metaEnum);
     void writeContainerConverterInitialization(QTextStream& s, const AbstractMetaType* type);
+    /// Adds the names the converter of a class or enum is looked up with to \p names, which maps them to type indices.
+    void addConverterNames(QMap<QString, QString>& names, const AbstractMetaClass* metaClass);
+    void addConverterNames(QMap<QString, QString>& names, const TypeEntry* enumType);
     void writeExtendedConverterInitialization(QTextStream& s, const TypeEntry* externalType, const QList<const AbstractMetaClass*>& conversions);
 
     void writeParentChildManagement(QTextStream& s, const AbstractMetaFunction* func, bool userHeuristicForReturn);
@@ -288,6 +299,12 @@ private:
 
     /// Write default implementations for sequence protocol
     void writeStdListWrapperMethods(QTextStream& s, const AbstractMetaClass* metaClass);
+    /// Returns true if the sequence protocol of \p metaClass is the one written by writeStdListWrapperMethods.
+    bool usesStdListWrapperMethods(const AbstractMetaClass* metaClass);
+    /// Helper function for writeStdListWrapperMethods, writes the subscript function that also accepts slices.
+    void writeStdListSubscriptFunction(QTextStream& s, const AbstractMetaClass* metaClass, const AbstractMetaType* itemType);
+    /// Helper function for writeStdListWrapperMethods, writes the functions of the container iterator.
+    void writeStdListIteratorFunctions(QTextStream& s, const AbstractMetaClass* metaClass, const AbstractMetaType* itemType);
     /// Helper function for writeStdListWrapperMethods.
     void writeIndexError(QTextStream& s, const QString& errorMsg);
 
@@ -145,6 +145,12 @@ void HeaderGenerator::generateClass(QTextStream& s, const AbstractMetaClass* met
         if (usePySideExtensions())
             s << INDENT << "static void pysideInitQtMetaTypes();" << endl;
 
+        int overrideCacheSize = overrideCachedFunctions(metaClass).size();
+        if (overrideCacheSize) {
+            s << "private:" << endl;
+            s << INDENT << "mutable Shiboken::OverrideCache<" << overrideCacheSize << "> m_overrideCache;" << endl;
+        }
+
         s << "};" << endl << endl;
     }
 
@@ -388,6 +394,8 @@ void HeaderGenerator::finishGeneration()
     s << "#include <sbkenum.h>" << endl;
     s << "#include <basewrapper.h>" << endl;
     s << "#include <bindingmanager.h>" << endl;
+    if (useLazyTypeInit())
+        s << "#include <sbkmodule.h>" << endl;
     s << "#include <memory>" << endl << endl;
     if (usePySideExtensions())
         s << "#include <pysidesignal.h>" << endl;
@@ -23,6 +23,7 @@
 
 #include "shibokengenerator.h"
 #include "overloaddata.h"
+#include <codesniptemplate.h>
 #include <reporthandler.h>
 #include <typedatabase.h>
 
@@ -38,6 +39,7 @@
 #define ENABLE_PYSIDE_EXTENSIONS "enable-pyside-extensions"
 #define DISABLE_VERBOSE_ERROR_MESSAGES "disable-verbose-error-messages"
 #define USE_ISNULL_AS_NB_NONZERO "use-isnull-as-nb_nonzero"
+#define LAZY_TYPE_INIT "enable-lazy-type-init"
 
 //static void dumpFunction(AbstractMetaFunctionList lst);
 
@@ -525,6 +527,18 @@ QString ShibokenGenerator::cpythonWrapperCPtr(const TypeEntry* type, QString arg
               .arg(argName);
 }
 
+QString ShibokenGenerator::cpythonWrapperSelfCPtr(const AbstractMetaClass* metaClass, QString argName)
+{
+    // Classes with multiple inheritance always need the special cast function,
+    // the others take the C++ pointer directly unless self mixes several C++ bases.
+    if (hasMultipleInheritanceInAncestry(metaClass))
+        return cpythonWrapperCPtr(metaClass, argName);
+    return QString("((::%1*)Shiboken::Object::cppSelfPointer((SbkObject*)%2, %3))")
+              .arg(metaClass->typeEntry()->qualifiedCppName())
+              .arg(argName)
+              .arg(cpythonTypeNameExt(metaClass->typeEntry()));
+}
+
 QString ShibokenGenerator::getFunctionReturnType(const AbstractMetaFunction* func, Options options) const
 {
     if (func->ownerClass() && (func->isConstructor() || func->isCopyConstructor()))
@@ -691,6 +705,15 @@ QString ShibokenGenerator::cpythonTypeName(const TypeEntry* type)
 }
 
 QString ShibokenGenerator::cpythonTypeNameExt(const TypeEntry* type)
+{
+    if (useLazyTypeInit()) {
+        return QString("Shiboken::Module::getType(%1, %2)")
+                  .arg(cppApiVariableName(type->targetLangPackage())).arg(getTypeIndexVariableName(type));
+    }
+    return cpythonTypeSlot(type);
+}
+
+QString ShibokenGenerator::cpythonTypeSlot(const TypeEntry* type)
 {
     return cppApiVariableName(type->targetLangPackage()) + '[' + getTypeIndexVariableName(type) + ']';
 }
@@ -726,6 +749,10 @@ QString ShibokenGenerator::converterObject(const TypeEntry* type)
 
 QString ShibokenGenerator::cpythonTypeNameExt(const AbstractMetaType* type)
 {
+    if (useLazyTypeInit()) {
+        return QString("Shiboken::Module::getType(%1, %2)")
+                  .arg(cppApiVariableName(type->typeEntry()->targetLangPackage())).arg(getTypeIndexVariableName(type));
+    }
     return cppApiVariableName(type->typeEntry()->targetLangPackage()) + '[' + getTypeIndexVariableName(type) + ']';
 }
 
@@ -1336,6 +1363,26 @@ AbstractMetaFunctionList ShibokenGenerator::filterFunctions(const AbstractMetaCl
     return result;
 }
 
+AbstractMetaFunctionList ShibokenGenerator::overrideCachedFunctions(const AbstractMetaClass* metaClass)
+{
+    AbstractMetaFunctionList result;
+    if (!shouldGenerateCppWrapper(metaClass) || (avoidProtectedHack() && metaClass->hasPrivateDestructor()))
+        return result;
+    foreach (AbstractMetaFunction* func, filterFunctions(metaClass)) {
+        if ((func->isPrivate() && !visibilityModifiedToPrivate(func)) || func->isModifiedRemoved())
+            continue;
+        // Abstract methods must report the missing override, and injected code may need
+        // to run even when there is no override.
+        if (func->isConstructor() || !func->isVirtual() || func->isAbstract() || func->hasInjectedCode())
+            continue;
+        if (usePySideExtensions() && metaClass->isQObject()
+            && (func->name() == "metaObject" || func->name() == "qt_metacall"))
+            continue;
+        result << func;
+    }
+    return result;
+}
+
 ShibokenGenerator::ExtendedConverterData ShibokenGenerator::getExtendedConverters() const
 {
     ExtendedConverterData extConvs;
@@ -1415,25 +1462,35 @@ QString ShibokenGenerator::getCodeSnippets(const CodeSnipList& codeSnips,
 }
 void ShibokenGenerator::processCodeSnip(QString& code, const AbstractMetaClass* context)
 {
+    // The code was formatted for this very function, so it is scanned on the spot.
+    CodeSnipTemplate tmpl(code);
     if (context) {
         // Replace template variable by the Python Type object
         // for the class context in which the variable is used.
-        code.replace("%PYTHONTYPEOBJECT", cpythonTypeName(context) + ".super.ht_type");
-        code.replace("%TYPE", wrapperName(context));
-        code.replace("%CPPTYPE", context->name());
+        QHash<QString, QString> values;
+        values["PYTHONTYPEOBJECT"] = cpythonTypeName(context) + ".super.ht_type";
+        values["TYPE"] = wrapperName(context);
+        values["CPPTYPE"] = context->name();
+        code = tmpl.render(values);
     }
 
+    // The converter variables are only searched for when the snippet uses them;
+    // rendering the context variables does not add or remove any of them.
     // replace "toPython" converters
-    replaceConvertToPythonTypeSystemVariable(code);
+    if (tmpl.uses("CONVERTTOPYTHON"))
+        replaceConvertToPythonTypeSystemVariable(code);
 
     // replace "toCpp" converters
-    replaceConvertToCppTypeSystemVariable(code);
+    if (tmpl.uses("CONVERTTOCPP"))
+        replaceConvertToCppTypeSystemVariable(code);
 
     // replace "isConvertible" check
-    replaceIsConvertibleToCppTypeSystemVariable(code);
+    if (tmpl.uses("ISCONVERTIBLE"))
+        replaceIsConvertibleToCppTypeSystemVariable(code);
 
     // replace "checkType" check
-    replaceTypeCheckTypeSystemVariable(code);
+    if (tmpl.uses("CHECKTYPE"))
+        replaceTypeCheckTypeSystemVariable(code);
 }
 
 ShibokenGenerator::ArgumentVarReplacementList ShibokenGenerator::getArgumentReplacement(const AbstractMetaFunction* func,
@@ -1512,67 +1569,121 @@ void ShibokenGenerator::writeCodeSnips(QTextStream& s,
     if (code.isEmpty())
         return;
 
-    // Calculate the real number of arguments.
-    int argsRemoved = 0;
-    for (int i = 0; i < func->arguments().size(); i++) {
-        if (func->argumentRemoved(i+1))
-            argsRemoved++;
-    }
-
     OverloadData od(getFunctionGroups(func->implementingClass())[func->name()], this);
     bool usePyArgs = pythonFunctionWrapperUsesListOfArguments(od);
 
+    // The rewrites that span more than one variable are done on the text before
+    // the template is rendered; everything else is a single substitution pass.
+    QString pySelf = (language == TypeSystem::NativeCode) ? "pySelf" : PYTHON_SELF_VAR;
+    CodeSnipTemplate tmpl(code);
+    QHash<QString, QString> values;
+
     // Replace %PYARG_# variables.
-    code.replace("%PYARG_0", PYTHON_RETURN_VAR);
+    values["PYARG_0"] = PYTHON_RETURN_VAR;
+    if (language == TypeSystem::NativeCode) {
+        // Replaces the simplest case of attribution to a
+        // Python argument on the binding virtual method.
+        foreach (const QString& var, tmpl.variables()) {
+            if (var.startsWith("PYARG_") && var != "PYARG_0") {
+                static QRegExp pyArgsAttributionRegex("%PYARG_(\\d+)\\s*=[^=]\\s*([^;]+)");
+                code.replace("%PYARG_0", PYTHON_RETURN_VAR);
+                code.replace(pyArgsAttributionRegex, "PyTuple_SET_ITEM(" PYTHON_ARGS ", \\1-1, \\2)");
+                tmpl = CodeSnipTemplate(code);
+                break;
+            }
+        }
+    }
 
-    static QRegExp pyArgsRegex("%PYARG_(\\d+)");
-    if (language == TypeSystem::TargetLangCode) {
-        if (usePyArgs) {
-            code.replace(pyArgsRegex, PYTHON_ARGS"[\\1-1]");
-        } else {
-            static QRegExp pyArgsRegexCheck("%PYARG_([2-9]+)");
-            if (pyArgsRegexCheck.indexIn(code) != -1) {
-                ReportHandler::warning("Wrong index for %PYARG variable ("+pyArgsRegexCheck.cap(1)+") on "+func->signature());
+    if (func->implementingClass() && func->isVirtual() && !func->isAbstract()
+        && (!avoidProtectedHack() || !func->isProtected())
+        && tmpl.uses("CPPSELF") && tmpl.uses("FUNCTION_NAME")) {
+        QString methodCallArgs = getArgumentsFromMethodCall(code);
+        if (!methodCallArgs.isNull()) {
+            if (func->name() == "metaObject") {
+                QString wrapperClassName = wrapperName(func->ownerClass());
+                QString cppSelfVar = avoidProtectedHack() ? QString("%CPPSELF") : QString("reinterpret_cast<%1*>(%CPPSELF)").arg(wrapperClassName);
+                code.replace(QString("%CPPSELF.%FUNCTION_NAME(%1)").arg(methodCallArgs),
+                             QString("(Shiboken::Object::hasCppWrapper(reinterpret_cast<SbkObject*>(%1))"
+                                     " ? %2->::%3::%FUNCTION_NAME(%4)"
+                                     " : %CPPSELF.%FUNCTION_NAME(%4))").arg(pySelf).arg(cppSelfVar).arg(wrapperClassName).arg(methodCallArgs));
+            } else {
+                code.replace(QString("%CPPSELF.%FUNCTION_NAME(%1)").arg(methodCallArgs),
+                             QString("(Shiboken::Object::hasCppWrapper(reinterpret_cast<SbkObject*>(%1))"
+                                     " ? %CPPSELF->::%TYPE::%FUNCTION_NAME(%2)"
+                                     " : %CPPSELF.%FUNCTION_NAME(%2))").arg(pySelf).arg(methodCallArgs));
+            }
+            tmpl = CodeSnipTemplate(code);
+        }
+    }
+
+    if (avoidProtectedHack() && tmpl.uses("FUNCTION_NAME")) {
+        // If the function being processed was added by the user via type system,
+        // Shiboken needs to find out if there are other overloads for the same method
+        // name and if any of them is of the protected visibility. This is used to replace
+        // calls to %FUNCTION_NAME on user written custom code for calls to the protected
+        // dispatcher.
+        bool hasProtectedOverload = false;
+        if (func->isUserAdded()) {
+            foreach (const AbstractMetaFunction* f, getFunctionOverloads(func->ownerClass(), func->name()))
+                hasProtectedOverload |= f->isProtected();
+        }
+
+        if (func->isProtected() || hasProtectedOverload) {
+            if (tmpl.uses("TYPE")) {
+                code.replace("%TYPE::%FUNCTION_NAME",
+                             QString("%1::%2_protected")
+                             .arg(wrapperName(func->ownerClass()))
+                             .arg(func->originalName()));
+                tmpl = CodeSnipTemplate(code);
+            }
+            values["FUNCTION_NAME"] = QString("%1_protected").arg(func->originalName());
+        }
+    }
+
+    // Variables that depend on the argument positions.
+    foreach (const QString& var, tmpl.variables()) {
+        if (var.startsWith("PYARG_") && var != "PYARG_0") {
+            QString index = var.mid(6);
+            bool ok;
+            index.toInt(&ok);
+            if (!ok)
+                continue;
+            if (language != TypeSystem::TargetLangCode) {
+                values[var] = QString("PyTuple_GET_ITEM(" PYTHON_ARGS ", %1-1)").arg(index);
+            } else if (usePyArgs) {
+                values[var] = QString(PYTHON_ARGS"[%1-1]").arg(index);
+            } else if (index.at(0) >= '2' && index.at(0) <= '9') {
+                ReportHandler::warning("Wrong index for %PYARG variable ("+index+") on "+func->signature());
                 return;
+            } else if (index == "1") {
+                values[var] = PYTHON_ARG;
             }
-            code.replace("%PYARG_1", PYTHON_ARG);
         }
-    } else {
-        // Replaces the simplest case of attribution to a
-        // Python argument on the binding virtual method.
-        static QRegExp pyArgsAttributionRegex("%PYARG_(\\d+)\\s*=[^=]\\s*([^;]+)");
-        code.replace(pyArgsAttributionRegex, "PyTuple_SET_ITEM(" PYTHON_ARGS ", \\1-1, \\2)");
-        code.replace(pyArgsRegex, "PyTuple_GET_ITEM(" PYTHON_ARGS ", \\1-1)");
     }
 
     // Replace %ARG#_TYPE variables.
-    foreach (const AbstractMetaArgument* arg, func->arguments()) {
-        QString argTypeVar = QString("%ARG%1_TYPE").arg(arg->argumentIndex() + 1);
-        QString argTypeVal = arg->type()->cppSignature();
-        code.replace(argTypeVar, argTypeVal);
-    }
+    foreach (const AbstractMetaArgument* arg, func->arguments())
+        values[QString("ARG%1_TYPE").arg(arg->argumentIndex() + 1)] = arg->type()->cppSignature();
 
-    int pos = 0;
-    static QRegExp cppArgTypeRegexCheck("%ARG(\\d+)_TYPE");
-    while ((pos = cppArgTypeRegexCheck.indexIn(code, pos)) != -1) {
-        ReportHandler::warning("Wrong index for %ARG#_TYPE variable ("+cppArgTypeRegexCheck.cap(1)+") on "+func->signature());
-        pos += cppArgTypeRegexCheck.matchedLength();
+    static QRegExp cppArgTypeRegexCheck("^ARG(\\d+)_TYPE$");
+    foreach (const QString& var, tmpl.variables()) {
+        if (!values.contains(var) && cppArgTypeRegexCheck.exactMatch(var))
+            ReportHandler::warning("Wrong index for %ARG#_TYPE variable ("+cppArgTypeRegexCheck.cap(1)+") on "+func->signature());
     }
 
     // Replace template variable for return variable name.
     if (func->isConstructor()) {
-        code.replace("%0.", QString("%1->").arg("cptr"));
-        code.replace("%0", "cptr");
+        values["0."] = "cptr->";
+        values["0"] = "cptr";
     } else if (func->type()) {
         QString returnValueOp = isPointerToWrapperType(func->type()) ? "%1->" : "%1.";
         if (ShibokenGenerator::isWrapperType(func->type()))
-            code.replace("%0.", returnValueOp.arg(CPP_RETURN_VAR));
-        code.replace("%0", CPP_RETURN_VAR);
+            values["0."] = returnValueOp.arg(CPP_RETURN_VAR);
+        values["0"] = CPP_RETURN_VAR;
     }
 
     // Replace template variable for self Python object.
-    QString pySelf = (language == TypeSystem::NativeCode) ? "pySelf" : PYTHON_SELF_VAR;
-    code.replace("%PYSELF", pySelf);
+    values["PYSELF"] = pySelf;
 
     // Replace template variable for a pointer to C++ of this object.
     if (func->implementingClass()) {
@@ -1589,32 +1700,13 @@ void ShibokenGenerator::writeCodeSnips(QTextStream& s,
         if (func->isComparisonOperator())
             replacement = "%1.";
 
-        if (func->isVirtual() && !func->isAbstract() && (!avoidProtectedHack() || !func->isProtected())) {
-            QString methodCallArgs = getArgumentsFromMethodCall(code);
-            if (!methodCallArgs.isNull()) {
-                if (func->name() == "metaObject") {
-                    QString wrapperClassName = wrapperName(func->ownerClass());
-                    QString cppSelfVar = avoidProtectedHack() ? QString("%CPPSELF") : QString("reinterpret_cast<%1*>(%CPPSELF)").arg(wrapperClassName);
-                    code.replace(QString("%CPPSELF.%FUNCTION_NAME(%1)").arg(methodCallArgs),
-                                 QString("(Shiboken::Object::hasCppWrapper(reinterpret_cast<SbkObject*>(%1))"
-                                         " ? %2->::%3::%FUNCTION_NAME(%4)"
-                                         " : %CPPSELF.%FUNCTION_NAME(%4))").arg(pySelf).arg(cppSelfVar).arg(wrapperClassName).arg(methodCallArgs));
-                } else {
-                    code.replace(QString("%CPPSELF.%FUNCTION_NAME(%1)").arg(methodCallArgs),
-                                 QString("(Shiboken::Object::hasCppWrapper(reinterpret_cast<SbkObject*>(%1))"
-                                         " ? %CPPSELF->::%TYPE::%FUNCTION_NAME(%2)"
-                                         " : %CPPSELF.%FUNCTION_NAME(%2))").arg(pySelf).arg(methodCallArgs));
-                }
-            }
-        }
-
-        code.replace("%CPPSELF.", replacement.arg(cppSelf));
-        code.replace("%CPPSELF", cppSelf);
+        values["CPPSELF."] = replacement.arg(cppSelf);
+        values["CPPSELF"] = cppSelf;
 
-        if (code.indexOf("%BEGIN_ALLOW_THREADS") > -1) {
-            if (code.count("%BEGIN_ALLOW_THREADS") == code.count("%END_ALLOW_THREADS")) {
-                code.replace("%BEGIN_ALLOW_THREADS", BEGIN_ALLOW_THREADS);
-                code.replace("%END_ALLOW_THREADS", END_ALLOW_THREADS);
+        if (tmpl.uses("BEGIN_ALLOW_THREADS")) {
+            if (tmpl.count("BEGIN_ALLOW_THREADS") == tmpl.count("END_ALLOW_THREADS")) {
+                values["BEGIN_ALLOW_THREADS"] = BEGIN_ALLOW_THREADS;
+                values["END_ALLOW_THREADS"] = END_ALLOW_THREADS;
             } else {
                 ReportHandler::warning("%BEGIN_ALLOW_THREADS and %END_ALLOW_THREADS mismatch");
             }
@@ -1623,10 +1715,10 @@ void ShibokenGenerator::writeCodeSnips(QTextStream& s,
         // replace template variable for the Python Type object for the
         // class implementing the method in which the code snip is written
         if (func->isStatic()) {
-            code.replace("%PYTHONTYPEOBJECT", cpythonTypeName(func->implementingClass()) + ".super.ht_type");
+            values["PYTHONTYPEOBJECT"] = cpythonTypeName(func->implementingClass()) + ".super.ht_type";
         } else {
-            code.replace("%PYTHONTYPEOBJECT.", QString("%1->ob_type->").arg(pySelf));
-            code.replace("%PYTHONTYPEOBJECT", QString("%1->ob_type").arg(pySelf));
+            values["PYTHONTYPEOBJECT."] = QString("%1->ob_type->").arg(pySelf);
+            values["PYTHONTYPEOBJECT"] = QString("%1->ob_type").arg(pySelf);
         }
     }
 
@@ -1634,17 +1726,21 @@ void ShibokenGenerator::writeCodeSnips(QTextStream& s,
     // Replaces template variables %# for individual arguments.
     ArgumentVarReplacementList argReplacements = getArgumentReplacement(func, usePyArgs, language, lastArg);
 
-    QStringList args;
-    foreach (ArgumentVarReplacementPair pair, argReplacements) {
-        if (pair.second.startsWith(CPP_ARG_REMOVED))
-            continue;
-        args << pair.second;
+    if (tmpl.uses("ARGUMENT_NAMES")) {
+        QStringList args;
+        foreach (ArgumentVarReplacementPair pair, argReplacements) {
+            if (pair.second.startsWith(CPP_ARG_REMOVED))
+                continue;
+            args << pair.second;
+        }
+        values["ARGUMENT_NAMES"] = args.join(", ");
     }
-    code.replace("%ARGUMENT_NAMES", args.join(", "));
 
     foreach (ArgumentVarReplacementPair pair, argReplacements) {
         const AbstractMetaArgument* arg = pair.first;
-        int idx = arg->argumentIndex() + 1;
+        QString idx = QString::number(arg->argumentIndex() + 1);
+        if (!tmpl.uses(idx))
+            continue;
         AbstractMetaType* type = arg->type();
         QString typeReplaced = func->typeReplaced(arg->argumentIndex() + 1);
         if (!typeReplaced.isEmpty()) {
@@ -1657,48 +1753,29 @@ void ShibokenGenerator::writeCodeSnips(QTextStream& s,
             if (type->isReference() && !isPointer(type))
                 replacement.remove(0, 1);
             if (type->isReference() || isPointer(type))
-                code.replace(QString("%%1.").arg(idx), QString("%1->").arg(replacement));
+                values[idx + '.'] = QString("%1->").arg(replacement);
         }
-        code.replace(QString("%%1").arg(idx), pair.second);
+        values[idx] = pair.second;
     }
 
     if (language == TypeSystem::NativeCode) {
         // Replaces template %PYTHON_ARGUMENTS variable with a pointer to the Python tuple
         // containing the converted virtual method arguments received from C++ to be passed
         // to the Python override.
-        code.replace("%PYTHON_ARGUMENTS", PYTHON_ARGS);
+        values["PYTHON_ARGUMENTS"] = PYTHON_ARGS;
 
         // replace variable %PYTHON_METHOD_OVERRIDE for a pointer to the Python method
         // override for the C++ virtual method in which this piece of code was inserted
-        code.replace("%PYTHON_METHOD_OVERRIDE", PYTHON_OVERRIDE_VAR);
-    }
-
-    if (avoidProtectedHack()) {
-        // If the function being processed was added by the user via type system,
-        // Shiboken needs to find out if there are other overloads for the same method
-        // name and if any of them is of the protected visibility. This is used to replace
-        // calls to %FUNCTION_NAME on user written custom code for calls to the protected
-        // dispatcher.
-        bool hasProtectedOverload = false;
-        if (func->isUserAdded()) {
-            foreach (const AbstractMetaFunction* f, getFunctionOverloads(func->ownerClass(), func->name()))
-                hasProtectedOverload |= f->isProtected();
-        }
-
-        if (func->isProtected() || hasProtectedOverload) {
-            code.replace("%TYPE::%FUNCTION_NAME",
-                         QString("%1::%2_protected")
-                         .arg(wrapperName(func->ownerClass()))
-                         .arg(func->originalName()));
-            code.replace("%FUNCTION_NAME", QString("%1_protected").arg(func->originalName()));
-        }
+        values["PYTHON_METHOD_OVERRIDE"] = PYTHON_OVERRIDE_VAR;
     }
 
     if (func->isConstructor() && shouldGenerateCppWrapper(func->ownerClass()))
-        code.replace("%TYPE", wrapperName(func->ownerClass()));
+        values["TYPE"] = wrapperName(func->ownerClass());
 
     if (func->ownerClass())
-        code.replace("%CPPTYPE", func->ownerClass()->name());
+        values["CPPTYPE"] = func->ownerClass()->name();
+
+    code = tmpl.render(values);
 
     replaceTemplateVariables(code, func);
 
@@ -1893,7 +1970,8 @@ bool ShibokenGenerator::injectedCodeCallsPythonOverride(const AbstractMetaFuncti
     static QRegExp overrideCallRegexCheck("PyObject_Call\\s*\\(\\s*%PYTHON_METHOD_OVERRIDE\\s*,");
     CodeSnipList snips = func->injectedCodeSnips(CodeSnip::Any, TypeSystem::NativeCode);
     foreach (CodeSnip snip, snips) {
-        if (overrideCallRegexCheck.indexIn(snip.code()) != -1)
+        if (snip.codeTemplate().uses("PYTHON_METHOD_OVERRIDE")
+            && overrideCallRegexCheck.indexIn(snip.code()) != -1)
             return true;
     }
     return false;
@@ -1905,11 +1983,12 @@ bool ShibokenGenerator::injectedCodeHasReturnValueAttribution(const AbstractMeta
     static QRegExp retValAttributionRegexCheck_target("%PYARG_0\\s*=[^=]\\s*.+");
     CodeSnipList snips = func->injectedCodeSnips(CodeSnip::Any, language);
     foreach (CodeSnip snip, snips) {
+        const CodeSnipTemplate& tmpl = snip.codeTemplate();
         if (language == TypeSystem::TargetLangCode) {
-            if (retValAttributionRegexCheck_target.indexIn(snip.code()) != -1)
+            if (tmpl.uses("PYARG_0") && retValAttributionRegexCheck_target.indexIn(snip.code()) != -1)
                 return true;
         } else {
-            if (retValAttributionRegexCheck_native.indexIn(snip.code()) != -1)
+            if (tmpl.uses("0") && retValAttributionRegexCheck_native.indexIn(snip.code()) != -1)
                 return true;
         }
     }
@@ -2221,6 +2300,7 @@ QMap<QString, QString> ShibokenGenerator::options() const
     opts.insert(ENABLE_PYSIDE_EXTENSIONS, "Enable PySide extensions, such as support for signal/slots, use this if you are creating a binding for a Qt-based library.");
     opts.insert(DISABLE_VERBOSE_ERROR_MESSAGES, "Disable verbose error messages. Turn the python code hard to debug but safe few kB on the generated bindings.");
     opts.insert(USE_ISNULL_AS_NB_NONZERO, "If a class have an isNull()const method, it will be used to compute the value of boolean casts");
+    opts.insert(LAZY_TYPE_INIT, "Create the module's classes on their first use instead of at import time.");
     return opts;
 }
 
@@ -2257,6 +2337,7 @@ bool ShibokenGenerator::doSetup(const QMap<QString, QString>& args)
     m_verboseErrorMessagesDisabled = args.contains(DISABLE_VERBOSE_ERROR_MESSAGES);
     m_useIsNullAsNbNonZero = args.contains(USE_ISNULL_AS_NB_NONZERO);
     m_avoidProtectedHack = args.contains(AVOID_PROTECTED_HACK);
+    m_useLazyTypeInit = args.contains(LAZY_TYPE_INIT);
 
     TypeDatabase* td = TypeDatabase::instance();
     QStringList snips;
@@ -2322,6 +2403,11 @@ bool ShibokenGenerator::avoidProtectedHack() const
     return m_avoidProtectedHack;
 }
 
+bool ShibokenGenerator::useLazyTypeInit() const
+{
+    return m_useLazyTypeInit;
+}
+
 QString ShibokenGenerator::cppApiVariableName(const QString& moduleName) const
 {
     QString result = moduleName.isEmpty() ? ShibokenGenerator::packageName() : moduleName;
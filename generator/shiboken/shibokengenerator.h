@@ -344,6 +344,8 @@ public:
     QString cpythonTypeName(const TypeEntry* type);
     QString cpythonTypeNameExt(const TypeEntry* type);
     QString cpythonTypeNameExt(const AbstractMetaType* type);
+    /// Returns the entry of the module's types array for \p type, to be assigned when the type is created.
+    QString cpythonTypeSlot(const TypeEntry* type);
     QString cpythonCheckFunction(const TypeEntry* type, bool genericNumberType = false);
     QString cpythonCheckFunction(const AbstractMetaType* metaType, bool genericNumberType = false);
     /**
@@ -381,6 +383,8 @@ public:
     QString cpythonWrapperCPtr(const AbstractMetaClass* metaClass, QString argName = PYTHON_SELF_VAR);
     QString cpythonWrapperCPtr(const AbstractMetaType* metaType, QString argName);
     QString cpythonWrapperCPtr(const TypeEntry* type, QString argName);
+    /// Same as cpythonWrapperCPtr, but for the wrapper used as self in a method of \p metaClass.
+    QString cpythonWrapperSelfCPtr(const AbstractMetaClass* metaClass, QString argName = PYTHON_SELF_VAR);
 
     /// Guesses the scope to where belongs an argument's default value.
     QString guessScopeForDefaultValue(const AbstractMetaFunction* func, const AbstractMetaArgument* arg);
@@ -421,6 +425,8 @@ public:
     bool usePySideExtensions() const;
     /// Returns true if the generator should use the result of isNull()const to compute boolean casts.
     bool useIsNullAsNbNonZero() const;
+    /// Returns true if the generated module creates its types on first use rather than at import.
+    bool useLazyTypeInit() const;
     /// Returns true if the generated code should use the "#define protected public" hack.
     bool avoidProtectedHack() const;
     QString cppApiVariableName(const QString& moduleName = QString()) const;
@@ -494,6 +500,13 @@ protected:
 
     AbstractMetaFunctionList filterFunctions(const AbstractMetaClass* metaClass);
 
+    /**
+     *   Returns the virtual methods of the C++ wrapper for \p metaClass that remember when they
+     *   are not overridden in Python, in the order of their slots in the wrapper's override cache.
+     *   Calls to these methods skip the override lookup when there is no Python override.
+     */
+    AbstractMetaFunctionList overrideCachedFunctions(const AbstractMetaClass* metaClass);
+
     // All data about extended converters: the type entries of the target type, and a
     // list of AbstractMetaClasses accepted as argument for the conversion.
     typedef QHash<const TypeEntry*, QList<const AbstractMetaClass*> > ExtendedConverterData;
@@ -524,6 +537,7 @@ private:
     bool m_verboseErrorMessagesDisabled;
     bool m_useIsNullAsNbNonZero;
     bool m_avoidProtectedHack;
+    bool m_useLazyTypeInit;
 
     typedef QHash<QString, AbstractMetaType*> AbstractMetaTypeCache;
     AbstractMetaTypeCache m_metaTypeFromStringCache;
@@ -27,23 +27,30 @@
 #include "autodecref.h"
 #include "typeresolver.h"
 #include "gilstate.h"
+#include "google/dense_hash_set"
 #include <string>
 #include <cstring>
 #include <cstddef>
 #include <set>
+#include <vector>
 #include <sstream>
 #include <algorithm>
 #include "threadstatesaver.h"
 
 namespace {
     void _destroyParentInfo(SbkObject* obj, bool keepReference);
+    void _detachChild(SbkObject* child, bool giveOwnershipBack, bool keepReference);
 }
 
 extern "C"
 {
 
+// Number of slots in the copy cache of a value type, see Shiboken::ObjectType::findCachedCopy().
+static const std::size_t COPY_CACHE_SIZE = 64;
+
 static void SbkObjectTypeDealloc(PyObject* pyObj);
 static PyObject* SbkObjectTypeTpNew(PyTypeObject* metatype, PyObject* args, PyObject* kwds);
+static int SbkObjectTypeSetAttro(PyObject* type, PyObject* name, PyObject* value);
 
 PyTypeObject SbkObjectType_Type = {
     PyVarObject_HEAD_INIT(0, 0)
@@ -63,7 +70,7 @@ PyTypeObject SbkObjectType_Type = {
     /*tp_call*/             0,
     /*tp_str*/              0,
     /*tp_getattro*/         0,
-    /*tp_setattro*/         PyObject_GenericSetAttr,
+    /*tp_setattro*/         SbkObjectTypeSetAttro,
     /*tp_as_buffer*/        0,
     /*tp_flags*/            Py_TPFLAGS_DEFAULT|Py_TPFLAGS_BASETYPE,
     /*tp_doc*/              0,
@@ -99,10 +106,26 @@ static PyObject* SbkObjectGetDict(SbkObject* obj)
         obj->ob_dict = PyDict_New();
     if (!obj->ob_dict)
         return 0;
+    Shiboken::Object::trackWrapper(obj);
+    // Whatever is added through the dictionary can't be seen.
+    obj->d->dictMayHaveOverrides = 1;
     Py_INCREF(obj->ob_dict);
     return obj->ob_dict;
 }
 
+static int SbkObjectSetAttro(PyObject* self, PyObject* name, PyObject* value)
+{
+    SbkObject* sbkSelf = reinterpret_cast<SbkObject*>(self);
+    // A callable in the instance dictionary may override a virtual method, see Shiboken::OverrideCache.
+    if (value && PyCallable_Check(value))
+        sbkSelf->d->dictMayHaveOverrides = 1;
+    int result = PyObject_GenericSetAttr(self, name, value);
+    // The instance dictionary is created by the first attribute stored in it.
+    if (sbkSelf->ob_dict)
+        Shiboken::Object::trackWrapper(sbkSelf);
+    return result;
+}
+
 static PyGetSetDef SbkObjectGetSetList[] = {
     {const_cast<char*>("__dict__"), (getter)SbkObjectGetDict, 0},
     {0} // Sentinel
@@ -170,7 +193,7 @@ SbkObjectType SbkObject_Type = { { {
     /*tp_call*/             0,
     /*tp_str*/              0,
     /*tp_getattro*/         0,
-    /*tp_setattro*/         0,
+    /*tp_setattro*/         SbkObjectSetAttro,
     /*tp_as_buffer*/        0,
     /*tp_flags*/            Py_TPFLAGS_DEFAULT|Py_TPFLAGS_BASETYPE|Py_TPFLAGS_HAVE_GC,
     /*tp_doc*/              0,
@@ -243,6 +266,21 @@ void SbkDeallocWrapperWithPrivateDtor(PyObject* self)
     Shiboken::Object::deallocData(sbkObj, true);
 }
 
+static unsigned int typeModifications = 0;
+
+int SbkObjectTypeSetAttro(PyObject* type, PyObject* name, PyObject* value)
+{
+    // type.__setattr__ refuses to change static types, which the wrapped C++ classes are.
+    int result = PyObject_GenericSetAttr(type, name, value);
+    if (!result) {
+        // The interpreter's method cache relies on the version tag of the type and its subclasses.
+        PyType_Modified(reinterpret_cast<PyTypeObject*>(type));
+        // Invalidates the records of every override cache, see Shiboken::OverrideCache.
+        ++typeModifications;
+    }
+    return result;
+}
+
 void SbkObjectTypeDealloc(PyObject* pyObj)
 {
     SbkObjectType* sbkType = reinterpret_cast<SbkObjectType*>(pyObj);
@@ -256,6 +294,14 @@ void SbkObjectTypeDealloc(PyObject* pyObj)
         }
         free(sbkType->d->original_name);
         sbkType->d->original_name = 0;
+        if (sbkType->d->copy_cache) {
+            for (std::size_t i = 0; i < COPY_CACHE_SIZE; ++i)
+                Py_XDECREF(sbkType->d->copy_cache[i]);
+            delete[] sbkType->d->copy_cache;
+            sbkType->d->copy_cache = 0;
+        }
+        delete[] sbkType->d->base_indexes;
+        sbkType->d->base_indexes = 0;
         if (!Shiboken::ObjectType::isUserType(reinterpret_cast<PyTypeObject*>(sbkType)))
             Shiboken::Conversions::deleteConverter(sbkType->d->converter);
         delete sbkType->d;
@@ -264,6 +310,34 @@ void SbkObjectTypeDealloc(PyObject* pyObj)
     Py_TRASHCAN_SAFE_END(pyObj);
 }
 
+// Builds the table used by Shiboken::cppBaseIndex() for a type inheriting from the C++ \p bases:
+// every type in the MRO of a base is mapped to the index of the first base inheriting from it,
+// which is what a walk with GetIndexVisitor would return.
+static SbkBaseIndex* buildBaseIndexes(const std::list<SbkObjectType*>& bases)
+{
+    std::vector<SbkBaseIndex> entries;
+    int index = 0;
+    std::list<SbkObjectType*>::const_iterator it = bases.begin();
+    for (; it != bases.end(); ++it, ++index) {
+        PyObject* mro = reinterpret_cast<PyTypeObject*>(*it)->tp_mro;
+        for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE(mro); ++i) {
+            PyTypeObject* type = reinterpret_cast<PyTypeObject*>(PyTuple_GET_ITEM(mro, i));
+            std::vector<SbkBaseIndex>::const_iterator entry = entries.begin();
+            while (entry != entries.end() && entry->type != type)
+                ++entry;
+            if (entry == entries.end()) {
+                SbkBaseIndex newEntry = { type, index };
+                entries.push_back(newEntry);
+            }
+        }
+    }
+    SbkBaseIndex* table = new SbkBaseIndex[entries.size() + 1];
+    std::copy(entries.begin(), entries.end(), table);
+    table[entries.size()].type = 0;
+    table[entries.size()].index = -1;
+    return table;
+}
+
 PyObject* SbkObjectTypeTpNew(PyTypeObject* metatype, PyObject* args, PyObject* kwds)
 {
 #ifndef IS_PY3K
@@ -317,6 +391,8 @@ PyObject* SbkObjectTypeTpNew(PyTypeObject* metatype, PyObject* args, PyObject* k
         d->cpp_dtor = 0;
         d->is_multicpp = 1;
         d->converter = 0;
+        d->cpp_base_count = bases.size();
+        d->base_indexes = buildBaseIndexes(bases);
     }
     if (bases.size() == 1)
         d->original_name = strdup(bases.front()->d->original_name);
@@ -342,7 +418,7 @@ PyObject* SbkObjectTpNew(PyTypeObject* subtype, PyObject*, PyObject*)
     SbkObjectPrivate* d = new SbkObjectPrivate;
 
     SbkObjectType* sbkType = reinterpret_cast<SbkObjectType*>(subtype);
-    int numBases = ((sbkType->d && sbkType->d->is_multicpp) ? Shiboken::getNumberOfCppBaseClasses(subtype) : 1);
+    int numBases = Shiboken::cppBaseCount(sbkType);
     d->cptr = new void*[numBases];
     std::memset(d->cptr, 0, sizeof(void*)*numBases);
     d->hasOwnership = 1;
@@ -351,10 +427,16 @@ PyObject* SbkObjectTpNew(PyTypeObject* subtype, PyObject*, PyObject*)
     d->parentInfo = 0;
     d->referredObjects = 0;
     d->cppObjectCreated = 0;
+    d->gcTracked = 0;
+    d->dictMayHaveOverrides = 0;
+    d->overrideCache = 0;
     self->ob_dict = 0;
     self->weakreflist = 0;
     self->d = d;
-    PyObject_GC_Track(reinterpret_cast<PyObject*>(self));
+    // Instances of Python subclasses may reference other objects through slots or the type itself,
+    // instances of wrapped types are only tracked when they start referring to other objects.
+    if (sbkType->d && sbkType->d->is_user_type)
+        Shiboken::Object::trackWrapper(self);
     return reinterpret_cast<PyObject*>(self);
 }
 
@@ -369,16 +451,45 @@ void _destroyParentInfo(SbkObject* obj, bool keepReference)
 {
     Shiboken::ParentInfo* pInfo = obj->d->parentInfo;
     if (pInfo) {
-        while(!pInfo->children.empty()) {
-            SbkObject* first = *pInfo->children.begin();
-            // Mark child as invalid
-            Shiboken::Object::invalidate(first);
-            Shiboken::Object::removeParent(first, false, keepReference);
+        while (!pInfo->children.empty()) {
+            std::vector<SbkObject*> children(pInfo->children.begin(), pInfo->children.end());
+            // Mark children as invalid
+            Shiboken::Object::invalidate(children);
+            // Releasing a child may run code that detaches or destroys other children, so
+            // each one must still be in the list when its turn comes.
+            for (std::size_t i = 0; i < children.size(); ++i) {
+                if (pInfo->children.erase(children[i]))
+                    _detachChild(children[i], false, keepReference);
+            }
         }
         Shiboken::Object::removeParent(obj, false);
     }
 }
 
+// Second half of Object::removeParent(), for a child already taken out of its parent's children list.
+void _detachChild(SbkObject* child, bool giveOwnershipBack, bool keepReference)
+{
+    Shiboken::ParentInfo* pInfo = child->d->parentInfo;
+    pInfo->parent = 0;
+
+    // This will keep the wrapper reference, will wait for wrapper destruction to remove that
+    if (keepReference &&
+        child->d->containsCppWrapper) {
+        //If have already a extra ref remove this one
+        if (pInfo->hasWrapperRef)
+            Py_DECREF(child);
+        else
+            pInfo->hasWrapperRef = true;
+        return;
+    }
+
+    // Transfer ownership back to Python
+    child->d->hasOwnership = giveOwnershipBack;
+
+    // Remove parent ref
+    Py_DECREF(child);
+}
+
 }
 
 namespace Shiboken
@@ -552,6 +663,11 @@ class FindBaseTypeVisitor : public HierarchyVisitor
         PyTypeObject* m_typeToFind;
 };
 
+unsigned int typeModificationCount()
+{
+    return typeModifications;
+}
+
 std::list<SbkObject*> splitPyObject(PyObject* pyObj)
 {
     std::list<SbkObject*> result;
@@ -732,6 +848,52 @@ void setTypeUserData(SbkObjectType* self, void* userData, DeleteUserDataFunc d_f
     self->d->d_func = d_func;
 }
 
+// FNV-1a hash of the value bytes, used to pick a copy cache slot.
+static std::size_t copyCacheSlot(const void* cppIn, std::size_t size)
+{
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(cppIn);
+    unsigned int hash = 2166136261u;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash % COPY_CACHE_SIZE;
+}
+
+PyObject* findCachedCopy(SbkObjectType* type, const void* cppIn, std::size_t size)
+{
+    PyObject** cache = type->d->copy_cache;
+    if (!cache)
+        return 0;
+    PyObject* pyObj = cache[copyCacheSlot(cppIn, size)];
+    if (!pyObj)
+        return 0;
+    // The wrapper may have been invalidated or changed since it was cached.
+    SbkObject* sbkObj = reinterpret_cast<SbkObject*>(pyObj);
+    if (!sbkObj->d->validCppObject || !sbkObj->d->cptr[0]
+        || std::memcmp(sbkObj->d->cptr[0], cppIn, size) != 0) {
+        return 0;
+    }
+    Py_INCREF(pyObj);
+    return pyObj;
+}
+
+void cacheCopy(SbkObjectType* type, PyObject* pyObj, std::size_t size)
+{
+    if (!pyObj)
+        return;
+    SbkObject* sbkObj = reinterpret_cast<SbkObject*>(pyObj);
+    if (!sbkObj->d->cptr[0])
+        return;
+    if (!type->d->copy_cache)
+        type->d->copy_cache = new PyObject*[COPY_CACHE_SIZE]();
+    PyObject*& slot = type->d->copy_cache[copyCacheSlot(sbkObj->d->cptr[0], size)];
+    PyObject* previous = slot;
+    Py_INCREF(pyObj);
+    slot = pyObj;
+    Py_XDECREF(previous);
+}
+
 } // namespace ObjectType
 
 
@@ -756,20 +918,14 @@ Py_hash_t hash(PyObject* pyObj)
 
 static void setSequenceOwnership(PyObject* pyObj, bool owner)
 {
-    if (PySequence_Check(pyObj)) {
-        std::list<SbkObject*> objs = splitPyObject(pyObj);
-        std::list<SbkObject*>::const_iterator it = objs.begin();
-        for(; it != objs.end(); ++it) {
-            if (owner)
-                getOwnership(*it);
-            else
-                releaseOwnership(*it);
-        }
-    } else if (Object::checkType(pyObj)) {
+    // A wrapper is transferred by itself, even if its type implements the sequence protocol.
+    if (Object::checkType(pyObj)) {
         if (owner)
             getOwnership(reinterpret_cast<SbkObject*>(pyObj));
         else
             releaseOwnership(reinterpret_cast<SbkObject*>(pyObj));
+    } else if (PySequence_Check(pyObj)) {
+        transferOwnershipMany(pyObj, owner);
     }
 }
 
@@ -861,54 +1017,135 @@ void releaseOwnership(PyObject* self)
     setSequenceOwnership(self, false);
 }
 
+void transferOwnershipMany(PyObject* objects, bool toPython)
+{
+    if (!objects)
+        return;
+    if (Object::checkType(objects)) {
+        if (toPython)
+            getOwnership(reinterpret_cast<SbkObject*>(objects));
+        else
+            releaseOwnership(reinterpret_cast<SbkObject*>(objects));
+        return;
+    }
+    if (!PySequence_Check(objects))
+        return;
+
+    AutoDecRef seq(PySequence_Fast(objects, "Invalid ownership transfer sequence."));
+    if (seq.isNull())
+        return;
+    const Py_ssize_t size = PySequence_Fast_GET_SIZE(seq.object());
+
+    if (toPython) {
+        for (Py_ssize_t i = 0; i < size; ++i) {
+            PyObject* item = PySequence_Fast_GET_ITEM(seq.object(), i);
+            if (Object::checkType(item))
+                getOwnership(reinterpret_cast<SbkObject*>(item));
+        }
+        return;
+    }
+
+    // Same as releaseOwnership(SbkObject*), with the invalidations done in a single batch.
+    std::vector<SbkObject*> invalidated;
+    invalidated.reserve(size);
+    for (Py_ssize_t i = 0; i < size; ++i) {
+        PyObject* item = PySequence_Fast_GET_ITEM(seq.object(), i);
+        if (!Object::checkType(item))
+            continue;
+        SbkObject* self = reinterpret_cast<SbkObject*>(item);
+        SbkObjectType* selfType = reinterpret_cast<SbkObjectType*>(Py_TYPE(self));
+        if (!self->d->hasOwnership || Shiboken::Conversions::pythonTypeIsValueType(selfType->d->converter))
+            continue;
+
+        self->d->hasOwnership = false;
+        if (self->d->containsCppWrapper)
+            Py_INCREF((PyObject*) self);
+        else
+            invalidated.push_back(self);
+    }
+    if (!invalidated.empty())
+        invalidate(invalidated);
+}
+
 void invalidate(PyObject* pyobj)
 {
     std::list<SbkObject*> objs = splitPyObject(pyobj);
-    std::list<SbkObject*>::const_iterator it = objs.begin();
-    for(; it != objs.end(); it++)
-        invalidate(*it);
+    invalidate(std::vector<SbkObject*>(objs.begin(), objs.end()));
 }
 
 void invalidate(SbkObject* self)
 {
-    // Skip if this object not is a valid object
-    if (!self || ((PyObject*)self == Py_None))
-        return;
+    invalidate(std::vector<SbkObject*>(1, self));
+}
 
-    if (!self->d->containsCppWrapper) {
-        self->d->validCppObject = false; // Mark object as invalid only if this is not a wrapper class
-        BindingManager::instance().releaseWrapper(self);
+void invalidate(const std::vector<SbkObject*>& objects)
+{
+    // Collect the trees first, children and referred objects included, each object once.
+    // Everything but the given objects is held with an extra reference, since detaching a
+    // child from its parent below may release it before the whole tree is processed.
+    // Objects already being deallocated are not held, as a reference would revive them.
+    std::vector<SbkObject*> tree;
+    std::vector<SbkObject*> held;
+    google::dense_hash_set<SbkObject*> visited;
+    visited.set_empty_key(0);
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+        SbkObject* obj = objects[i];
+        // Skip if this object not is a valid object
+        if (obj && ((PyObject*)obj != Py_None) && visited.insert(obj).second)
+            tree.push_back(obj);
     }
-
-    // If it is a parent invalidate all children.
-    if (self->d->parentInfo) {
-        // Create a copy because this list can be changed during the process
-        ChildrenList copy = self->d->parentInfo->children;
-        ChildrenList::iterator it = copy.begin();
-
-        for (; it != copy.end(); ++it) {
-            // invalidate the child
-            invalidate(*it);
-
-            // if the parent not is a wrapper class, then remove children from him, because We do not know when this object will be destroyed
-            if (!self->d->validCppObject)
-                removeParent(*it, true, true);
+    const std::size_t rootCount = tree.size();
+
+    for (std::size_t i = 0; i < tree.size(); ++i) {
+        SbkObject* obj = tree[i];
+        if (obj->d->parentInfo) {
+            const ChildrenList& children = obj->d->parentInfo->children;
+            for (ChildrenList::const_iterator it = children.begin(); it != children.end(); ++it) {
+                if (visited.insert(*it).second)
+                    tree.push_back(*it);
+            }
+        }
+        if (obj->d->referredObjects) {
+            RefCountMap& refCountMap = *(obj->d->referredObjects);
+            for (RefCountMap::iterator iter = refCountMap.begin(); iter != refCountMap.end(); ++iter) {
+                const std::list<PyObject*>& lst = iter->second;
+                for (std::list<PyObject*>::const_iterator it = lst.begin(); it != lst.end(); ++it) {
+                    std::list<SbkObject*> referred = splitPyObject(*it);
+                    for (std::list<SbkObject*>::const_iterator r = referred.begin(); r != referred.end(); ++r) {
+                        if (*r && ((PyObject*)*r != Py_None) && visited.insert(*r).second)
+                            tree.push_back(*r);
+                    }
+                }
+            }
         }
     }
 
-    // If has ref to other objects invalidate all
-    if (self->d->referredObjects) {
-        RefCountMap& refCountMap = *(self->d->referredObjects);
-        RefCountMap::iterator iter;
-        for (iter = refCountMap.begin(); iter != refCountMap.end(); ++iter) {
-            const std::list<PyObject*> lst = iter->second;
-            std::list<PyObject*>::const_iterator it = lst.begin();
-            while(it != lst.end()) {
-                invalidate(*it);
-                ++it;
-            }
+    // Mark objects as invalid only if they are not wrapper classes, and forget them all at once.
+    std::vector<SbkObject*> released;
+    for (std::size_t i = 0; i < tree.size(); ++i) {
+        if (i >= rootCount && ((PyObject*)tree[i])->ob_refcnt > 0) {
+            Py_INCREF(tree[i]);
+            held.push_back(tree[i]);
         }
+        if (!tree[i]->d->containsCppWrapper && tree[i]->d->cptr)
+            released.push_back(tree[i]);
+    }
+    if (!released.empty())
+        BindingManager::instance().releaseWrappers(released);
+
+    // If a parent is not a wrapper class remove its children from it, because we do not know when it will be destroyed.
+    for (std::size_t i = 0; i < tree.size(); ++i) {
+        SbkObject* obj = tree[i];
+        if (!obj->d->parentInfo || obj->d->validCppObject || obj->d->parentInfo->children.empty())
+            continue;
+        ChildrenList children;
+        children.swap(obj->d->parentInfo->children);
+        for (ChildrenList::iterator it = children.begin(); it != children.end(); ++it)
+            _detachChild(*it, true, true);
     }
+
+    for (std::size_t i = held.size(); i > 0; --i)
+        Py_DECREF(held[i - 1]);
 }
 
 void makeValid(SbkObject* self)
@@ -950,18 +1187,25 @@ bool hasParentInfo(SbkObject* pyObj)
 
 void* cppPointer(SbkObject* pyObj, PyTypeObject* desiredType)
 {
-    PyTypeObject* type = Py_TYPE(pyObj);
-    int idx = 0;
-    if (reinterpret_cast<SbkObjectType*>(type)->d->is_multicpp)
-        idx = getTypeIndexOnHierarchy(type, desiredType);
+    int idx = cppBaseIndex(reinterpret_cast<SbkObjectType*>(Py_TYPE(pyObj)), desiredType);
     if (pyObj->d->cptr)
         return pyObj->d->cptr[idx];
     return 0;
 }
 
+void* cppSelfPointer(SbkObject* pyObj, PyTypeObject* desiredType)
+{
+    SbkObjectTypePrivate* d = reinterpret_cast<SbkObjectType*>(Py_TYPE(pyObj))->d;
+    if (d->is_multicpp || d->mi_specialcast)
+        return Conversions::cppPointer(desiredType, pyObj);
+    if (pyObj->d->cptr)
+        return pyObj->d->cptr[0];
+    return 0;
+}
+
 std::vector<void*> cppPointers(SbkObject* pyObj)
 {
-    int n = getNumberOfCppBaseClasses(Py_TYPE(pyObj));
+    int n = cppBaseCount(reinterpret_cast<SbkObjectType*>(Py_TYPE(pyObj)));
     std::vector<void*> ptrs(n);
     for (int i = 0; i < n; ++i)
         ptrs[i] = pyObj->d->cptr[i];
@@ -971,9 +1215,7 @@ std::vector<void*> cppPointers(SbkObject* pyObj)
 
 bool setCppPointer(SbkObject* sbkObj, PyTypeObject* desiredType, void* cptr)
 {
-    int idx = 0;
-    if (reinterpret_cast<SbkObjectType*>(Py_TYPE(sbkObj))->d->is_multicpp)
-        idx = getTypeIndexOnHierarchy(Py_TYPE(sbkObj), desiredType);
+    int idx = cppBaseIndex(reinterpret_cast<SbkObjectType*>(Py_TYPE(sbkObj)), desiredType);
 
     bool alreadyInitialized = sbkObj->d->cptr[idx];
     if (alreadyInitialized)
@@ -1124,52 +1366,18 @@ void removeParent(SbkObject* child, bool giveOwnershipBack, bool keepReference)
 
     ChildrenList& oldBrothers = pInfo->parent->d->parentInfo->children;
     // Verify if this child is part of parent list
-    ChildrenList::iterator iChild = std::find(oldBrothers.begin(), oldBrothers.end(), child);
+    ChildrenList::iterator iChild = oldBrothers.find(child);
     if (iChild == oldBrothers.end())
         return;
 
     oldBrothers.erase(iChild);
-
-    pInfo->parent = 0;
-
-    // This will keep the wrapper reference, will wait for wrapper destruction to remove that
-    if (keepReference &&
-        child->d->containsCppWrapper) {
-        //If have already a extra ref remove this one
-        if (pInfo->hasWrapperRef)
-            Py_DECREF(child);
-        else
-            pInfo->hasWrapperRef = true;
-        return;
-    }
-
-    // Transfer ownership back to Python
-    child->d->hasOwnership = giveOwnershipBack;
-
-    // Remove parent ref
-    Py_DECREF(child);
+    _detachChild(child, giveOwnershipBack, keepReference);
 }
 
-void setParent(PyObject* parent, PyObject* child)
+// Does the work of setParent() for a single wrapped child, except adding it to the parent's
+// children set. Returns true if the caller must add the child there.
+static bool attachChild(PyObject* parent, PyObject* child)
 {
-    if (!child || child == Py_None || child == parent)
-        return;
-
-    /*
-     *  setParent is recursive when the child is a native Python sequence, i.e. objects not binded by Shiboken
-     *  like tuple and list.
-     *
-     *  This "limitation" exists to fix the following problem: A class multiple inherits QObject and QString,
-     *  so if you pass this class to someone that takes the ownership, we CAN'T enter in this if, but hey! QString
-     *  follows the sequence protocol.
-     */
-    if (PySequence_Check(child) && !Object::checkType(child)) {
-        Shiboken::AutoDecRef seq(PySequence_Fast(child, 0));
-        for (int i = 0, max = PySequence_Size(seq); i < max; ++i)
-            setParent(parent, PySequence_Fast_GET_ITEM(seq.object(), i));
-        return;
-    }
-
     bool parentIsNull = !parent || parent == Py_None;
     SbkObject* parent_ = reinterpret_cast<SbkObject*>(parent);
     SbkObject* child_ = reinterpret_cast<SbkObject*>(child);
@@ -1177,10 +1385,11 @@ void setParent(PyObject* parent, PyObject* child)
     if (!parentIsNull) {
         if (!parent_->d->parentInfo)
             parent_->d->parentInfo = new ParentInfo;
+        trackWrapper(parent_);
 
         // do not re-add a child
         if (child_->d->parentInfo && (child_->d->parentInfo->parent == parent_))
-            return;
+            return false;
     }
 
     ParentInfo* pInfo = child_->d->parentInfo;
@@ -1200,7 +1409,6 @@ void setParent(PyObject* parent, PyObject* child)
             pInfo = child_->d->parentInfo = new ParentInfo;
 
         pInfo->parent = parent_;
-        parent_->d->parentInfo->children.insert(child_);
 
         // Add Parent ref
         Py_INCREF(child_);
@@ -1211,6 +1419,62 @@ void setParent(PyObject* parent, PyObject* child)
 
     // Remove previous safe ref
     Py_DECREF(child);
+    return !parentIsNull;
+}
+
+void setParent(PyObject* parent, PyObject* child)
+{
+    if (!child || child == Py_None || child == parent)
+        return;
+
+    /*
+     *  setParent is recursive when the child is a native Python sequence, i.e. objects not binded by Shiboken
+     *  like tuple and list.
+     *
+     *  This "limitation" exists to fix the following problem: A class multiple inherits QObject and QString,
+     *  so if you pass this class to someone that takes the ownership, we CAN'T enter in this if, but hey! QString
+     *  follows the sequence protocol.
+     */
+    if (PySequence_Check(child) && !Object::checkType(child)) {
+        setParentMany(parent, child);
+        return;
+    }
+
+    if (attachChild(parent, child))
+        reinterpret_cast<SbkObject*>(parent)->d->parentInfo->children.insert(reinterpret_cast<SbkObject*>(child));
+}
+
+void setParentMany(PyObject* parent, PyObject* children)
+{
+    if (!children || children == Py_None || children == parent)
+        return;
+    if (!PySequence_Check(children) || Object::checkType(children)) {
+        setParent(parent, children);
+        return;
+    }
+
+    Shiboken::AutoDecRef seq(PySequence_Fast(children, 0));
+    if (seq.isNull())
+        return;
+    const Py_ssize_t size = PySequence_Fast_GET_SIZE(seq.object());
+
+    // The new children are collected and added to the parent's children set at once.
+    std::vector<SbkObject*> added;
+    added.reserve(size);
+    for (Py_ssize_t i = 0; i < size; ++i) {
+        PyObject* child = PySequence_Fast_GET_ITEM(seq.object(), i);
+        if (!child || child == Py_None || child == parent)
+            continue;
+        if (PySequence_Check(child) && !Object::checkType(child))
+            setParentMany(parent, child);
+        else if (attachChild(parent, child))
+            added.push_back(reinterpret_cast<SbkObject*>(child));
+    }
+
+    if (!added.empty()) {
+        std::sort(added.begin(), added.end());
+        reinterpret_cast<SbkObject*>(parent)->d->parentInfo->children.insert(added.begin(), added.end());
+    }
 }
 
 void deallocData(SbkObject* self, bool cleanup)
@@ -1257,6 +1521,7 @@ void keepReference(SbkObject* self, const char* key, PyObject* referredObject, b
 
     if (!self->d->referredObjects)
         self->d->referredObjects = new Shiboken::RefCountMap;
+    trackWrapper(self);
 
     RefCountMap& refCountMap = *(self->d->referredObjects);
     RefCountMap::iterator iter = refCountMap.find(key);
@@ -1304,6 +1569,14 @@ void removeReference(SbkObject* self, const char* key, PyObject* referredObject)
     }
 }
 
+void trackWrapper(SbkObject* self)
+{
+    if (self->d->gcTracked)
+        return;
+    self->d->gcTracked = 1;
+    PyObject_GC_Track(reinterpret_cast<PyObject*>(self));
+}
+
 void clearReferences(SbkObject* self)
 {
     if (!self->d->referredObjects)
@@ -25,6 +25,7 @@
 
 #include "sbkpython.h"
 #include "bindingmanager.h"
+#include <cstddef>
 #include <list>
 #include <vector>
 #include <map>
@@ -210,6 +211,23 @@ LIBSHIBOKEN_API void        setSubTypeInitHook(SbkObjectType* self, SubTypeInitH
 LIBSHIBOKEN_API void*       getTypeUserData(SbkObjectType* self);
 LIBSHIBOKEN_API void        setTypeUserData(SbkObjectType* self, void* userData, DeleteUserDataFunc d_func);
 
+/**
+ *  Looks for a wrapper of a value type copy with the same contents of \p cppIn.
+ *  Used by the copy conversions of value types marked with copy-cache="yes", whose
+ *  instances are compared byte by byte and must therefore be trivially copyable.
+ *  \param type    The wrapper type of the value type.
+ *  \param cppIn   The C++ value about to be copied to Python.
+ *  \param size    The size in bytes of the C++ value.
+ *  \returns       A new reference to a cached wrapper holding an equal value, or null if there is none.
+ */
+LIBSHIBOKEN_API PyObject*   findCachedCopy(SbkObjectType* type, const void* cppIn, std::size_t size);
+/**
+ *  Stores the value type copy wrapper \p pyObj in the copy cache of \p type,
+ *  replacing any other wrapper that took the same slot.
+ *  \see findCachedCopy
+ */
+LIBSHIBOKEN_API void        cacheCopy(SbkObjectType* type, PyObject* pyObj, std::size_t size);
+
 }
 
 namespace Object {
@@ -305,6 +323,15 @@ LIBSHIBOKEN_API void        releaseOwnership(PyObject* pyObj);
  */
 LIBSHIBOKEN_API void        releaseOwnership(SbkObject* pyObj);
 
+/**
+ *  Gives the ownership of every wrapped object in the sequence \p objects to Python, if
+ *  \p toPython is true, or to C++ otherwise. Objects that must be invalidated because C++
+ *  can't tell when they are deleted are invalidated all at once.
+ *  If \p objects isn't a sequence this is the same as getOwnership(PyObject*) or
+ *  releaseOwnership(PyObject*).
+ */
+LIBSHIBOKEN_API void        transferOwnershipMany(PyObject* objects, bool toPython);
+
 /**
  *  Returns true if the pyObj holds information about their parents.
  */
@@ -315,6 +342,13 @@ LIBSHIBOKEN_API bool        hasParentInfo(SbkObject* pyObj);
  */
 LIBSHIBOKEN_API void*       cppPointer(SbkObject* pyObj, PyTypeObject* desiredType);
 
+/**
+ *   Get the C++ pointer of a Python object used as self on a method of the wrapped \p desiredType.
+ *   Objects whose type has neither multiple inheritance nor a special cast function hold a single
+ *   C++ pointer, which is returned right away; the others are handled by Conversions::cppPointer().
+ */
+LIBSHIBOKEN_API void*       cppSelfPointer(SbkObject* pyObj, PyTypeObject* desiredType);
+
 /**
  *   Return a list with all C++ pointers held from a Python object.
  *   \note This function was added to libshiboken only to be used by shiboken.getCppPointer()
@@ -353,6 +387,12 @@ LIBSHIBOKEN_API bool        isValid(PyObject* pyObj, bool throwPyError);
 */
 LIBSHIBOKEN_API void        setParent(PyObject* parent, PyObject* child);
 
+/**
+*   Same as setParent(PyObject*, PyObject*) for a sequence of \p children, but the children
+*   are added to the parent in a single step.
+*/
+LIBSHIBOKEN_API void        setParentMany(PyObject* parent, PyObject* children);
+
 /**
 *   Remove this child from their parent, if any.
 *   \param child the child.
@@ -375,6 +415,13 @@ LIBSHIBOKEN_API void        invalidate(SbkObject* self);
  **/
 LIBSHIBOKEN_API void        invalidate(PyObject* pyobj);
 
+/**
+ * Same as calling invalidate(SbkObject*) for each one of \p objects, but the object trees
+ * are collected first and released from the BindingManager in a single pass.
+ * The cost is linear in the number of objects in the trees.
+ */
+LIBSHIBOKEN_API void        invalidate(const std::vector<SbkObject*>& objects);
+
 /**
  * Make the object valid again
  */
@@ -57,6 +57,8 @@ struct ParentInfo
     bool hasWrapperRef;
 };
 
+class OverrideCacheBase;
+
 } // namespace Shiboken
 
 extern "C"
@@ -78,6 +80,12 @@ struct SbkObjectPrivate
     unsigned int validCppObject : 1;
     /// Marked as true when the object constructor was called
     unsigned int cppObjectCreated : 1;
+    /// Marked as true when the wrapper is tracked by the garbage collector, see Object::trackWrapper().
+    unsigned int gcTracked : 1;
+    /// Marked as true when a callable was stored in the instance dictionary or the dictionary was handed out.
+    unsigned int dictMayHaveOverrides : 1;
+    /// Methods of the C++ wrapper known not to be overridden, may be null. See Shiboken::OverrideCache.
+    Shiboken::OverrideCacheBase* overrideCache;
     /// Information about the object parents and children, may be null.
     Shiboken::ParentInfo* parentInfo;
     /// Manage reference count of objects that are referred to but not owned from.
@@ -100,6 +108,13 @@ struct SbkObjectPrivate
 /// The type is an object type
 #define BEHAVIOUR_OBJECTTYPE 2
 
+/// Entry of the table mapping a type to the C++ object that inherits from it, see Shiboken::cppBaseIndex().
+struct SbkBaseIndex
+{
+    PyTypeObject* type;
+    int index;
+};
+
 struct SbkObjectTypePrivate
 {
     SbkConverter* converter;
@@ -124,6 +139,12 @@ struct SbkObjectTypePrivate
     void* user_data;
     DeleteUserDataFunc d_func;
     void (*subtype_init)(SbkObjectType*, PyObject*, PyObject*);
+    /// Wrappers of recently returned value type copies, see ObjectType::findCachedCopy(); null until first used.
+    PyObject** copy_cache;
+    /// Number of C++ instances held by instances of a multiple C++ inheritance type, zero otherwise.
+    int cpp_base_count;
+    /// Null terminated table of the C++ base index of every type inherited by a multiple C++ inheritance type.
+    SbkBaseIndex* base_indexes;
 };
 
 
@@ -136,6 +157,12 @@ namespace Shiboken
  **/
 std::list<SbkObject*> splitPyObject(PyObject* pyObj);
 
+/**
+ * Returns how many times an attribute of a wrapped type, or of a Python type derived from one,
+ * was set or deleted.
+ */
+unsigned int typeModificationCount();
+
 /**
 *   Visitor class used by walkOnClassHierarchy function.
 */
@@ -248,6 +275,39 @@ inline std::list<SbkObjectType*> getCppBaseClasses(PyTypeObject* baseType)
     return visitor.bases();
 }
 
+/**
+*   Returns the number of C++ instances held by instances of \p type, using the value
+*   computed on type creation when available.
+*/
+inline int cppBaseCount(SbkObjectType* type)
+{
+    SbkObjectTypePrivate* d = type->d;
+    if (!d || !d->is_multicpp)
+        return 1;
+    if (d->cpp_base_count)
+        return d->cpp_base_count;
+    return getNumberOfCppBaseClasses(reinterpret_cast<PyTypeObject*>(type));
+}
+
+/**
+*   Returns the index of the C++ instance inheriting from \p desiredType among the ones held
+*   by instances of \p type. The base index table built on type creation is searched first,
+*   falling back to a walk on the class hierarchy for types not listed there.
+*/
+inline int cppBaseIndex(SbkObjectType* type, PyTypeObject* desiredType)
+{
+    SbkObjectTypePrivate* d = type->d;
+    if (!d || !d->is_multicpp)
+        return 0;
+    if (const SbkBaseIndex* entry = d->base_indexes) {
+        for (; entry->type; ++entry) {
+            if (entry->type == desiredType)
+                return entry->index;
+        }
+    }
+    return getTypeIndexOnHierarchy(reinterpret_cast<PyTypeObject*>(type), desiredType);
+}
+
 namespace Object
 {
 /**
@@ -256,6 +316,13 @@ namespace Object
 */
 void clearReferences(SbkObject* self);
 
+/**
+*   Makes the garbage collector track \p self. Wrappers start untracked, since a wrapper without
+*   children, kept references or instance dictionary can't take part in a reference cycle; they
+*   must be tracked as soon as they get any of those.
+*/
+void trackWrapper(SbkObject* self);
+
 /**
  * Destroy internal data
  **/
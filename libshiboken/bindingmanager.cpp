@@ -31,6 +31,7 @@
 
 #include <cstddef>
 #include <fstream>
+#include <vector>
 
 namespace Shiboken
 {
@@ -125,16 +126,31 @@ struct BindingManager::BindingManagerPrivate {
     bool destroying;
 
     BindingManagerPrivate() : destroying(false) {}
-    void releaseWrapper(void* cptr);
     void assignWrapper(SbkObject* wrapper, const void* cptr);
-
 };
 
-void BindingManager::BindingManagerPrivate::releaseWrapper(void* cptr)
+// Calls \p visitor with each C++ pointer \p sbkObj is registered with, one per C++ base
+// and per multiple inheritance offset.
+template<typename Visitor>
+static void visitWrapperKeys(SbkObject* sbkObj, Visitor& visitor)
 {
-    WrapperMap::iterator iter = wrapperMapper.find(cptr);
-    if (iter != wrapperMapper.end())
-        wrapperMapper.erase(iter);
+    SbkObjectType* sbkType = reinterpret_cast<SbkObjectType*>(Py_TYPE(sbkObj));
+    SbkObjectTypePrivate* d = sbkType->d;
+    int numBases = cppBaseCount(sbkType);
+
+    void** cptrs = sbkObj->d->cptr;
+    for (int i = 0; i < numBases; ++i) {
+        void* cptr = cptrs[i];
+        visitor(cptr);
+        if (d && d->mi_offsets) {
+            int* offset = d->mi_offsets;
+            while (*offset != -1) {
+                if (*offset > 0)
+                    visitor((void*) ((std::size_t) cptr + (*offset)));
+                offset++;
+            }
+        }
+    }
 }
 
 void BindingManager::BindingManagerPrivate::assignWrapper(SbkObject* wrapper, const void* cptr)
@@ -167,8 +183,15 @@ BindingManager::~BindingManager()
     /* Cleanup hanging references. We just invalidate them as when
      * the BindingManager is being destroyed the interpreter is alredy
      * shutting down. */
+    // Work on a snapshot of the map: destroying a wrapper releases all its entries and
+    // possibly the ones of its children, and asking the map for its first entry
+    // after each removal would make the cleanup quadratic.
     while (!m_d->wrapperMapper.empty()) {
-        Object::destroy(m_d->wrapperMapper.begin()->second, const_cast<void*>(m_d->wrapperMapper.begin()->first));
+        std::vector<std::pair<const void*, SbkObject*> > entries(m_d->wrapperMapper.begin(), m_d->wrapperMapper.end());
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            if (retrieveWrapper(entries[i].first) == entries[i].second)
+                Object::destroy(entries[i].second, const_cast<void*>(entries[i].first));
+        }
     }
     assert(m_d->wrapperMapper.size() == 0);
     delete m_d;
@@ -205,28 +228,75 @@ void BindingManager::registerWrapper(SbkObject* pyObj, void* cptr)
     }
 }
 
-void BindingManager::releaseWrapper(SbkObject* sbkObj)
+OverrideCacheBase::OverrideCacheBase(unsigned int* records, int size)
+    : m_wrapper(0), m_records(records), m_size(size)
 {
-    SbkObjectType* sbkType = reinterpret_cast<SbkObjectType*>(Py_TYPE(sbkObj));
-    SbkObjectTypePrivate* d = sbkType->d;
-    int numBases = ((d && d->is_multicpp) ? getNumberOfCppBaseClasses(Py_TYPE(sbkObj)) : 1);
+    for (int i = 0; i < m_size; ++i)
+        m_records[i] = 0;
+}
 
-    void** cptrs = reinterpret_cast<SbkObject*>(sbkObj)->d->cptr;
-    for (int i = 0; i < numBases; ++i) {
-        void* cptr = cptrs[i];
-        m_d->releaseWrapper(cptr);
-        if (d && d->mi_offsets) {
-            int* offset = d->mi_offsets;
-            while (*offset != -1) {
-                if (*offset > 0)
-                    m_d->releaseWrapper((void*) ((std::size_t) cptr + (*offset)));
-                offset++;
-            }
-        }
+bool OverrideCacheBase::isNotOverridden(int index) const
+{
+    return m_wrapper && m_records[index] == typeModificationCount() + 1
+        && !m_wrapper->d->dictMayHaveOverrides;
+}
+
+void OverrideCacheBase::clear()
+{
+    m_wrapper = 0;
+    for (int i = 0; i < m_size; ++i)
+        m_records[i] = 0;
+}
+
+static void forgetOverrides(SbkObject* wrapper)
+{
+    if (wrapper->d->overrideCache) {
+        wrapper->d->overrideCache->clear();
+        wrapper->d->overrideCache = 0;
+    }
+}
+
+// The changes made to the types are only seen if all of them are wrapped types or derived from one.
+static bool hasOnlyWrappedTypes(PyTypeObject* type)
+{
+    PyObject* mro = type->tp_mro;
+    // The last class in the mro is the base Python object class.
+    for (int i = 0; i < PyTuple_GET_SIZE(mro) - 1; ++i) {
+        if (!PyType_IsSubtype(Py_TYPE(PyTuple_GET_ITEM(mro, i)), &SbkObjectType_Type))
+            return false;
+    }
+    return true;
+}
+
+struct WrapperKeyReleaser
+{
+    WrapperMap* wrappers;
+    void operator()(void* cptr)
+    {
+        WrapperMap::iterator iter = wrappers->find(cptr);
+        if (iter != wrappers->end())
+            wrappers->erase(iter);
     }
+};
+
+void BindingManager::releaseWrapper(SbkObject* sbkObj)
+{
+    WrapperKeyReleaser releaser = { &m_d->wrapperMapper };
+    visitWrapperKeys(sbkObj, releaser);
+    forgetOverrides(sbkObj);
     sbkObj->d->validCppObject = false;
 }
 
+void BindingManager::releaseWrappers(const std::vector<SbkObject*>& wrappers)
+{
+    WrapperKeyReleaser releaser = { &m_d->wrapperMapper };
+    for (std::size_t i = 0; i < wrappers.size(); ++i) {
+        visitWrapperKeys(wrappers[i], releaser);
+        forgetOverrides(wrappers[i]);
+        wrappers[i]->d->validCppObject = false;
+    }
+}
+
 SbkObject* BindingManager::retrieveWrapper(const void* cptr)
 {
     WrapperMap::iterator iter = m_d->wrapperMapper.find(cptr);
@@ -236,6 +306,11 @@ SbkObject* BindingManager::retrieveWrapper(const void* cptr)
 }
 
 PyObject* BindingManager::getOverride(const void* cptr, const char* methodName)
+{
+    return getOverride(cptr, methodName, 0, 0);
+}
+
+PyObject* BindingManager::getOverride(const void* cptr, const char* methodName, OverrideCacheBase* cache, int index)
 {
     SbkObject* wrapper = retrieveWrapper(cptr);
     // The refcount can be 0 if the object is dieing and someone called
@@ -243,6 +318,9 @@ PyObject* BindingManager::getOverride(const void* cptr, const char* methodName)
     if (!wrapper || ((PyObject*)wrapper)->ob_refcnt == 0)
         return 0;
 
+    // Taken before the lookup, in case it runs code that modifies the types.
+    unsigned int modifications = typeModificationCount();
+
     if (wrapper->ob_dict) {
         PyObject* method = PyDict_GetItemString(wrapper->ob_dict, methodName);
         if (method) {
@@ -275,6 +353,16 @@ PyObject* BindingManager::getOverride(const void* cptr, const char* methodName)
 
     Py_XDECREF(method);
     Py_DECREF(pyMethodName);
+    if (cache && !PyErr_Occurred() && !wrapper->d->dictMayHaveOverrides
+        && hasOnlyWrappedTypes(Py_TYPE(wrapper))) {
+        if (cache->m_wrapper != wrapper) {
+            if (cache->m_wrapper)
+                forgetOverrides(cache->m_wrapper);
+            cache->m_wrapper = wrapper;
+            wrapper->d->overrideCache = cache;
+        }
+        cache->m_records[index] = modifications + 1;
+    }
     return 0;
 }
 
@@ -307,6 +395,7 @@ std::set<PyObject*> BindingManager::getAllPyObjects()
 
 void BindingManager::visitAllPyObjects(ObjectVisitor visitor, void* data)
 {
+    // The visitor may release wrappers, so it works on a copy.
     WrapperMap copy = m_d->wrapperMapper;
     for (WrapperMap::iterator it = copy.begin(); it != copy.end(); ++it) {
         if (hasWrapper(it->first))
@@ -25,6 +25,7 @@
 
 #include "sbkpython.h"
 #include <set>
+#include <vector>
 #include "shibokenmacros.h"
 
 struct SbkObject;
@@ -35,6 +36,13 @@ namespace Shiboken
 
 typedef void (*ObjectVisitor)(SbkObject*, void*);
 
+class OverrideCacheBase;
+
+/**
+ * Keeps track of the wrappers of the C++ objects and of the class hierarchy.
+ * \note The binding manager is not thread-safe on its own: every method must be called
+ *       with the GIL held, and the returned objects are borrowed references.
+ */
 class LIBSHIBOKEN_API BindingManager
 {
 public:
@@ -44,9 +52,19 @@ public:
 
     void registerWrapper(SbkObject* pyObj, void* cptr);
     void releaseWrapper(SbkObject* wrapper);
+    /**
+     * Same as calling releaseWrapper() for each one of \p wrappers.
+     */
+    void releaseWrappers(const std::vector<SbkObject*>& wrappers);
 
     SbkObject* retrieveWrapper(const void* cptr);
     PyObject* getOverride(const void* cptr, const char* methodName);
+    /**
+     * Same as getOverride(const void*, const char*), but when the method is known not to be
+     * overridden in Python it is recorded in the slot \p index of \p cache.
+     * \see OverrideCache
+     */
+    PyObject* getOverride(const void* cptr, const char* methodName, OverrideCacheBase* cache, int index);
 
     void addClassInheritance(SbkObjectType* parent, SbkObjectType* child);
     /**
@@ -86,6 +104,52 @@ private:
     BindingManagerPrivate* m_d;
 };
 
+/**
+ * Per instance record of the virtual methods of a C++ wrapper that are not overridden in Python.
+ * The generated wrapper classes keep one of these with a slot per virtual method, so that calls
+ * to methods without an override skip the lookup in the wrapper's dictionary and type hierarchy.
+ * A record holds until an attribute of a wrapped type, or of a Python type derived from one, is
+ * changed, or until a callable is stored in the wrapper's instance dictionary.
+ * \note Must be used with the GIL held. The binding manager forgets the records of a wrapper
+ *       when the wrapper is released.
+ */
+class LIBSHIBOKEN_API OverrideCacheBase
+{
+public:
+    /// Returns true if the method at \p index is known not to be overridden.
+    bool isNotOverridden(int index) const;
+
+    /// Forgets all the recorded methods.
+    void clear();
+
+protected:
+    OverrideCacheBase(unsigned int* records, int size);
+
+private:
+    friend class BindingManager;
+    // disable copy
+    OverrideCacheBase(const OverrideCacheBase&);
+    OverrideCacheBase& operator=(const OverrideCacheBase&);
+
+    SbkObject* m_wrapper;
+    // One past the type modification count seen when each method was recorded, 0 if not recorded.
+    unsigned int* m_records;
+    int m_size;
+};
+
+template<int N>
+class OverrideCache : public OverrideCacheBase
+{
+public:
+    OverrideCache() : OverrideCacheBase(m_entries, N) {}
+    // A copy belongs to another C++ object, which starts with nothing recorded.
+    OverrideCache(const OverrideCache&) : OverrideCacheBase(m_entries, N) {}
+    OverrideCache& operator=(const OverrideCache&) { return *this; }
+
+private:
+    unsigned int m_entries[N];
+};
+
 } // namespace Shiboken
 
 #endif // BINDINGMANAGER_H
@@ -25,13 +25,36 @@
 namespace Shiboken
 {
 
+// Returns the thread state holding the GIL without the fatal error
+// PyThreadState_Get() raises when there is none. Debug builds of old Python
+// versions have no such accessor, and the GIL is always taken there.
+static inline PyThreadState* currentThreadState()
+{
+#if PY_VERSION_HEX >= 0x030D0000
+    return PyThreadState_GetUnchecked();
+#elif PY_VERSION_HEX >= 0x03050200
+    return _PyThreadState_UncheckedGet();
+#elif !defined(Py_DEBUG)
+    return PyThreadState_GET();
+#else
+    return 0;
+#endif
+}
+
 GilState::GilState()
     : m_locked(false)
 {
-    if (Py_IsInitialized()) {
-        m_gstate = PyGILState_Ensure();
-        m_locked = true;
-    }
+    if (!Py_IsInitialized())
+        return;
+
+    // This thread already holds the GIL, as when C++ calls back into Python from a
+    // wrapped method, or from inside another GilState.
+    PyThreadState* tstate = currentThreadState();
+    if (tstate && tstate == PyGILState_GetThisThreadState())
+        return;
+
+    m_gstate = PyGILState_Ensure();
+    m_locked = true;
 }
 
 GilState::~GilState()
@@ -41,10 +64,11 @@ GilState::~GilState()
 
 void GilState::release()
 {
-    if (m_locked && Py_IsInitialized()) {
+    if (!m_locked)
+        return;
+    m_locked = false;
+    if (Py_IsInitialized())
         PyGILState_Release(m_gstate);
-        m_locked = false;
-    }
 }
 
 } // namespace Shiboken
@@ -29,6 +29,15 @@
 namespace Shiboken
 {
 
+/**
+ *   Acquires the GIL for the lifetime of the object.
+ *
+ *   Nothing is done when the current thread already holds the GIL, be it for
+ *   running Python code or through an outer GilState, so PyGILState_Ensure and
+ *   PyGILState_Release are only called when the GIL must really be taken.
+ *   If the GIL was released in between (e.g. by an allow-thread call) the
+ *   object acquires it for real.
+ */
 class LIBSHIBOKEN_API GilState
 {
 public:
@@ -38,6 +47,9 @@ public:
 private:
     PyGILState_STATE m_gstate;
     bool m_locked;
+
+    GilState(const GilState&);
+    GilState& operator=(const GilState&);
 };
 
 } // namespace Shiboken
@@ -0,0 +1,558 @@
+/*
+* This file is part of the Shiboken Python Bindings Generator project.
+*
+* Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+*
+* Contact: PySide team <contact@pyside.org>
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License along with this library; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "sbkcontainer.h"
+#include "autodecref.h"
+
+using Shiboken::Container::ViewState;
+
+extern "C"
+{
+
+struct SbkContainerIterator
+{
+    PyObject_HEAD
+    PyObject* container;
+    void* state;
+    Shiboken::Container::IteratorNextFunc next;
+    Shiboken::Container::IteratorStateDeleter deleteState;
+};
+
+static void SbkContainerIterator_release(SbkContainerIterator* iterator)
+{
+    if (iterator->state) {
+        iterator->deleteState(iterator->state);
+        iterator->state = 0;
+    }
+    Py_CLEAR(iterator->container);
+}
+
+static void SbkContainerIterator_dealloc(PyObject* self)
+{
+    PyObject_GC_UnTrack(self);
+    SbkContainerIterator_release(reinterpret_cast<SbkContainerIterator*>(self));
+    PyObject_GC_Del(self);
+}
+
+static int SbkContainerIterator_traverse(PyObject* self, visitproc visit, void* arg)
+{
+    Py_VISIT(reinterpret_cast<SbkContainerIterator*>(self)->container);
+    return 0;
+}
+
+static int SbkContainerIterator_clear(PyObject* self)
+{
+    SbkContainerIterator_release(reinterpret_cast<SbkContainerIterator*>(self));
+    return 0;
+}
+
+static PyObject* SbkContainerIterator_next(PyObject* self)
+{
+    SbkContainerIterator* iterator = reinterpret_cast<SbkContainerIterator*>(self);
+    if (!iterator->container)
+        return 0;
+    PyObject* item = iterator->next(iterator->container, iterator->state);
+    // Exhausted or failed, an iterator never resumes.
+    if (!item)
+        SbkContainerIterator_release(iterator);
+    return item;
+}
+
+static PyTypeObject SbkContainerIterator_Type = {
+    PyVarObject_HEAD_INIT(0, 0)
+    /*tp_name*/             "Shiboken.ContainerIterator",
+    /*tp_basicsize*/        sizeof(SbkContainerIterator),
+    /*tp_itemsize*/         0,
+    /*tp_dealloc*/          SbkContainerIterator_dealloc,
+    /*tp_print*/            0,
+    /*tp_getattr*/          0,
+    /*tp_setattr*/          0,
+    /*tp_compare*/          0,
+    /*tp_repr*/             0,
+    /*tp_as_number*/        0,
+    /*tp_as_sequence*/      0,
+    /*tp_as_mapping*/       0,
+    /*tp_hash*/             0,
+    /*tp_call*/             0,
+    /*tp_str*/              0,
+    /*tp_getattro*/         0,
+    /*tp_setattro*/         0,
+    /*tp_as_buffer*/        0,
+    /*tp_flags*/            Py_TPFLAGS_DEFAULT|Py_TPFLAGS_HAVE_GC,
+    /*tp_doc*/              0,
+    /*tp_traverse*/         SbkContainerIterator_traverse,
+    /*tp_clear*/            SbkContainerIterator_clear,
+    /*tp_richcompare*/      0,
+    /*tp_weaklistoffset*/   0,
+    /*tp_iter*/             PyObject_SelfIter,
+    /*tp_iternext*/         SbkContainerIterator_next,
+    /*tp_methods*/          0,
+    /*tp_members*/          0,
+    /*tp_getset*/           0,
+    /*tp_base*/             0,
+    /*tp_dict*/             0,
+    /*tp_descr_get*/        0,
+    /*tp_descr_set*/        0,
+    /*tp_dictoffset*/       0,
+    /*tp_init*/             0,
+    /*tp_alloc*/            0,
+    /*tp_new*/              0,
+    /*tp_free*/             0,
+    /*tp_is_gc*/            0,
+    /*tp_bases*/            0,
+    /*tp_mro*/              0,
+    /*tp_cache*/            0,
+    /*tp_subclasses*/       0,
+    /*tp_weaklist*/         0
+};
+
+struct SbkContainerView
+{
+    PyObject_HEAD
+    ViewState* state;
+};
+
+static inline ViewState* viewState(PyObject* self)
+{
+    return reinterpret_cast<SbkContainerView*>(self)->state;
+}
+
+static void SbkContainerView_dealloc(PyObject* self)
+{
+    delete viewState(self);
+    PyObject_Del(self);
+}
+
+static Py_ssize_t SbkContainerView_length(PyObject* self)
+{
+    return viewState(self)->size();
+}
+
+static PyObject* SbkContainerView_iterNext(PyObject* self, void* state)
+{
+    Py_ssize_t* pos = reinterpret_cast<Py_ssize_t*>(state);
+    if (*pos >= viewState(self)->size())
+        return 0;
+    return viewState(self)->item((*pos)++);
+}
+
+static void SbkContainerView_deleteIterState(void* state)
+{
+    delete reinterpret_cast<Py_ssize_t*>(state);
+}
+
+static PyObject* SbkContainerView_iter(PyObject* self)
+{
+    return Shiboken::Container::newIterator(self, new Py_ssize_t(0),
+                                            SbkContainerView_iterNext, SbkContainerView_deleteIterState);
+}
+
+static PyObject* SbkSequenceView_item(PyObject* self, Py_ssize_t index)
+{
+    if (index < 0 || index >= viewState(self)->size()) {
+        PyErr_SetString(PyExc_IndexError, "view index out of range");
+        return 0;
+    }
+    return viewState(self)->item(index);
+}
+
+static PyObject* SbkSequenceView_subscript(PyObject* self, PyObject* key)
+{
+    if (!PySlice_Check(key))
+        return Shiboken::Container::getIndexedItem(self, key);
+
+    Py_ssize_t start, stop, step, sliceLength;
+    if (!Shiboken::Container::sliceIndices(key, viewState(self)->size(), &start, &stop, &step, &sliceLength))
+        return 0;
+    PyObject* result = PyList_New(sliceLength);
+    if (!result)
+        return 0;
+    for (Py_ssize_t i = 0, index = start; i < sliceLength; ++i, index += step) {
+        PyObject* item = viewState(self)->item(index);
+        if (!item) {
+            Py_DECREF(result);
+            return 0;
+        }
+        PyList_SET_ITEM(result, i, item);
+    }
+    return result;
+}
+
+// Returns a new Python dictionary with all the items of a mapping view.
+static PyObject* SbkMappingView_toDict(PyObject* self)
+{
+    PyObject* result = PyDict_New();
+    if (!result)
+        return 0;
+    ViewState* state = viewState(self);
+    for (Py_ssize_t i = 0; i < state->size(); ++i) {
+        Shiboken::AutoDecRef key(state->item(i));
+        Shiboken::AutoDecRef value(key.isNull() ? 0 : state->lookup(key));
+        if (value.isNull() || PyDict_SetItem(result, key, value) < 0) {
+            Py_DECREF(result);
+            return 0;
+        }
+    }
+    return result;
+}
+
+static PyObject* SbkContainerView_materialize(PyObject* self)
+{
+    // Only sequence views provide sq_item.
+    if (PySequence_Check(self))
+        return PySequence_List(self);
+    return SbkMappingView_toDict(self);
+}
+
+static PyObject* SbkContainerView_repr(PyObject* self)
+{
+    Shiboken::AutoDecRef contents(SbkContainerView_materialize(self));
+    if (contents.isNull())
+        return 0;
+    return PyObject_Repr(contents);
+}
+
+static PyObject* SbkContainerView_richcompare(PyObject* self, PyObject* other, int op)
+{
+    Shiboken::AutoDecRef contents(SbkContainerView_materialize(self));
+    if (contents.isNull())
+        return 0;
+    return PyObject_RichCompare(contents, other, op);
+}
+
+static PyObject* SbkMappingView_subscript(PyObject* self, PyObject* key)
+{
+    return viewState(self)->lookup(key);
+}
+
+static int SbkMappingView_contains(PyObject* self, PyObject* key)
+{
+    PyObject* value = viewState(self)->lookup(key);
+    if (value) {
+        Py_DECREF(value);
+        return 1;
+    }
+    if (PyErr_ExceptionMatches(PyExc_KeyError)) {
+        PyErr_Clear();
+        return 0;
+    }
+    return -1;
+}
+
+static PyObject* SbkMappingView_keys(PyObject* self)
+{
+    return PySequence_List(self);
+}
+
+static PyObject* SbkMappingView_values(PyObject* self)
+{
+    ViewState* state = viewState(self);
+    PyObject* result = PyList_New(state->size());
+    if (!result)
+        return 0;
+    for (Py_ssize_t i = 0; i < state->size(); ++i) {
+        Shiboken::AutoDecRef key(state->item(i));
+        PyObject* value = key.isNull() ? 0 : state->lookup(key);
+        if (!value) {
+            Py_DECREF(result);
+            return 0;
+        }
+        PyList_SET_ITEM(result, i, value);
+    }
+    return result;
+}
+
+static PyObject* SbkMappingView_items(PyObject* self)
+{
+    ViewState* state = viewState(self);
+    PyObject* result = PyList_New(state->size());
+    if (!result)
+        return 0;
+    for (Py_ssize_t i = 0; i < state->size(); ++i) {
+        PyObject* key = state->item(i);
+        PyObject* value = key ? state->lookup(key) : 0;
+        if (!value) {
+            Py_XDECREF(key);
+            Py_DECREF(result);
+            return 0;
+        }
+        PyObject* item = PyTuple_New(2);
+        PyTuple_SET_ITEM(item, 0, key);
+        PyTuple_SET_ITEM(item, 1, value);
+        PyList_SET_ITEM(result, i, item);
+    }
+    return result;
+}
+
+static PyObject* SbkMappingView_get(PyObject* self, PyObject* args)
+{
+    PyObject* key;
+    PyObject* defaultValue = Py_None;
+    if (!PyArg_UnpackTuple(args, "get", 1, 2, &key, &defaultValue))
+        return 0;
+    PyObject* value = viewState(self)->lookup(key);
+    if (value || !PyErr_ExceptionMatches(PyExc_KeyError))
+        return value;
+    PyErr_Clear();
+    Py_INCREF(defaultValue);
+    return defaultValue;
+}
+
+static PySequenceMethods SbkSequenceView_as_sequence = {
+    /*sq_length*/           SbkContainerView_length,
+    /*sq_concat*/           0,
+    /*sq_repeat*/           0,
+    /*sq_item*/             SbkSequenceView_item,
+    /*sq_slice*/            0,
+    /*sq_ass_item*/         0,
+    /*sq_ass_slice*/        0,
+    /*sq_contains*/         0,
+    /*sq_inplace_concat*/   0,
+    /*sq_inplace_repeat*/   0
+};
+
+static PyMappingMethods SbkSequenceView_as_mapping = {
+    /*mp_length*/           SbkContainerView_length,
+    /*mp_subscript*/        SbkSequenceView_subscript,
+    /*mp_ass_subscript*/    0
+};
+
+static PyTypeObject SbkSequenceView_Type = {
+    PyVarObject_HEAD_INIT(0, 0)
+    /*tp_name*/             "Shiboken.SequenceView",
+    /*tp_basicsize*/        sizeof(SbkContainerView),
+    /*tp_itemsize*/         0,
+    /*tp_dealloc*/          SbkContainerView_dealloc,
+    /*tp_print*/            0,
+    /*tp_getattr*/          0,
+    /*tp_setattr*/          0,
+    /*tp_compare*/          0,
+    /*tp_repr*/             SbkContainerView_repr,
+    /*tp_as_number*/        0,
+    /*tp_as_sequence*/      &SbkSequenceView_as_sequence,
+    /*tp_as_mapping*/       &SbkSequenceView_as_mapping,
+    /*tp_hash*/             0,
+    /*tp_call*/             0,
+    /*tp_str*/              0,
+    /*tp_getattro*/         0,
+    /*tp_setattro*/         0,
+    /*tp_as_buffer*/        0,
+    /*tp_flags*/            Py_TPFLAGS_DEFAULT,
+    /*tp_doc*/              "Read-only view of a C++ sequence container.",
+    /*tp_traverse*/         0,
+    /*tp_clear*/            0,
+    /*tp_richcompare*/      SbkContainerView_richcompare,
+    /*tp_weaklistoffset*/   0,
+    /*tp_iter*/             SbkContainerView_iter,
+    /*tp_iternext*/         0,
+    /*tp_methods*/          0,
+    /*tp_members*/          0,
+    /*tp_getset*/           0,
+    /*tp_base*/             0,
+    /*tp_dict*/             0,
+    /*tp_descr_get*/        0,
+    /*tp_descr_set*/        0,
+    /*tp_dictoffset*/       0,
+    /*tp_init*/             0,
+    /*tp_alloc*/            0,
+    /*tp_new*/              0,
+    /*tp_free*/             0,
+    /*tp_is_gc*/            0,
+    /*tp_bases*/            0,
+    /*tp_mro*/              0,
+    /*tp_cache*/            0,
+    /*tp_subclasses*/       0,
+    /*tp_weaklist*/         0
+};
+
+static PySequenceMethods SbkMappingView_as_sequence = {
+    /*sq_length*/           0,
+    /*sq_concat*/           0,
+    /*sq_repeat*/           0,
+    /*sq_item*/             0,
+    /*sq_slice*/            0,
+    /*sq_ass_item*/         0,
+    /*sq_ass_slice*/        0,
+    /*sq_contains*/         SbkMappingView_contains,
+    /*sq_inplace_concat*/   0,
+    /*sq_inplace_repeat*/   0
+};
+
+static PyMappingMethods SbkMappingView_as_mapping = {
+    /*mp_length*/           SbkContainerView_length,
+    /*mp_subscript*/        SbkMappingView_subscript,
+    /*mp_ass_subscript*/    0
+};
+
+static PyMethodDef SbkMappingView_methods[] = {
+    {"keys", (PyCFunction)SbkMappingView_keys, METH_NOARGS, 0},
+    {"values", (PyCFunction)SbkMappingView_values, METH_NOARGS, 0},
+    {"items", (PyCFunction)SbkMappingView_items, METH_NOARGS, 0},
+    {"get", (PyCFunction)SbkMappingView_get, METH_VARARGS, 0},
+    {0, 0, 0, 0} // Sentinel
+};
+
+static PyTypeObject SbkMappingView_Type = {
+    PyVarObject_HEAD_INIT(0, 0)
+    /*tp_name*/             "Shiboken.MappingView",
+    /*tp_basicsize*/        sizeof(SbkContainerView),
+    /*tp_itemsize*/         0,
+    /*tp_dealloc*/          SbkContainerView_dealloc,
+    /*tp_print*/            0,
+    /*tp_getattr*/          0,
+    /*tp_setattr*/          0,
+    /*tp_compare*/          0,
+    /*tp_repr*/             SbkContainerView_repr,
+    /*tp_as_number*/        0,
+    /*tp_as_sequence*/      &SbkMappingView_as_sequence,
+    /*tp_as_mapping*/       &SbkMappingView_as_mapping,
+    /*tp_hash*/             0,
+    /*tp_call*/             0,
+    /*tp_str*/              0,
+    /*tp_getattro*/         0,
+    /*tp_setattro*/         0,
+    /*tp_as_buffer*/        0,
+    /*tp_flags*/            Py_TPFLAGS_DEFAULT,
+    /*tp_doc*/              "Read-only view of a C++ associative container.",
+    /*tp_traverse*/         0,
+    /*tp_clear*/            0,
+    /*tp_richcompare*/      SbkContainerView_richcompare,
+    /*tp_weaklistoffset*/   0,
+    /*tp_iter*/             SbkContainerView_iter,
+    /*tp_iternext*/         0,
+    /*tp_methods*/          SbkMappingView_methods,
+    /*tp_members*/          0,
+    /*tp_getset*/           0,
+    /*tp_base*/             0,
+    /*tp_dict*/             0,
+    /*tp_descr_get*/        0,
+    /*tp_descr_set*/        0,
+    /*tp_dictoffset*/       0,
+    /*tp_init*/             0,
+    /*tp_alloc*/            0,
+    /*tp_new*/              0,
+    /*tp_free*/             0,
+    /*tp_is_gc*/            0,
+    /*tp_bases*/            0,
+    /*tp_mro*/              0,
+    /*tp_cache*/            0,
+    /*tp_subclasses*/       0,
+    /*tp_weaklist*/         0
+};
+
+} // extern "C"
+
+namespace Shiboken
+{
+
+namespace Container
+{
+
+PyObject* newIterator(PyObject* container, void* state, IteratorNextFunc next, IteratorStateDeleter deleteState)
+{
+    if (!(SbkContainerIterator_Type.tp_flags & Py_TPFLAGS_READY) && PyType_Ready(&SbkContainerIterator_Type) < 0) {
+        deleteState(state);
+        return 0;
+    }
+    SbkContainerIterator* iterator = PyObject_GC_New(SbkContainerIterator, &SbkContainerIterator_Type);
+    if (!iterator) {
+        deleteState(state);
+        return 0;
+    }
+    Py_INCREF(container);
+    iterator->container = container;
+    iterator->state = state;
+    iterator->next = next;
+    iterator->deleteState = deleteState;
+    PyObject_GC_Track(iterator);
+    return reinterpret_cast<PyObject*>(iterator);
+}
+
+PyObject* getIndexedItem(PyObject* container, PyObject* key)
+{
+    if (!PyIndex_Check(key)) {
+        PyErr_Format(PyExc_TypeError, "%s indices must be integers or slices, not %s",
+                     Py_TYPE(container)->tp_name, Py_TYPE(key)->tp_name);
+        return 0;
+    }
+    Py_ssize_t index = PyNumber_AsSsize_t(key, PyExc_IndexError);
+    if (index == -1 && PyErr_Occurred())
+        return 0;
+    return PySequence_GetItem(container, index);
+}
+
+bool sliceIndices(PyObject* slice, Py_ssize_t length, Py_ssize_t* start,
+                  Py_ssize_t* stop, Py_ssize_t* step, Py_ssize_t* sliceLength)
+{
+#if PY_VERSION_HEX >= 0x03020000
+    return PySlice_GetIndicesEx(slice, length, start, stop, step, sliceLength) == 0;
+#else
+    return PySlice_GetIndicesEx(reinterpret_cast<PySliceObject*>(slice), length, start, stop, step, sliceLength) == 0;
+#endif
+}
+
+PyObject* ViewState::lookup(PyObject* key)
+{
+    PyErr_SetObject(PyExc_KeyError, key);
+    return 0;
+}
+
+const char* ViewState::stateTypeName() const
+{
+    return 0;
+}
+
+static PyObject* newView(PyTypeObject* type, ViewState* state)
+{
+    if (!(type->tp_flags & Py_TPFLAGS_READY) && PyType_Ready(type) < 0) {
+        delete state;
+        return 0;
+    }
+    SbkContainerView* view = PyObject_New(SbkContainerView, type);
+    if (!view) {
+        delete state;
+        return 0;
+    }
+    view->state = state;
+    return reinterpret_cast<PyObject*>(view);
+}
+
+PyObject* newSequenceView(ViewState* state)
+{
+    return newView(&SbkSequenceView_Type, state);
+}
+
+PyObject* newMappingView(ViewState* state)
+{
+    return newView(&SbkMappingView_Type, state);
+}
+
+ViewState* getViewState(PyObject* pyIn)
+{
+    if (Py_TYPE(pyIn) != &SbkSequenceView_Type && Py_TYPE(pyIn) != &SbkMappingView_Type)
+        return 0;
+    return viewState(pyIn);
+}
+
+} // namespace Container
+
+} // namespace Shiboken
@@ -0,0 +1,280 @@
+/*
+* This file is part of the Shiboken Python Bindings Generator project.
+*
+* Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+*
+* Contact: PySide team <contact@pyside.org>
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License along with this library; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef SBKCONTAINER_H
+#define SBKCONTAINER_H
+
+#include "sbkpython.h"
+#include "shibokenmacros.h"
+#include <iterator>
+#include <deque>
+#include <cstring>
+#include <typeinfo>
+
+namespace Shiboken
+{
+
+/**
+ *  Helpers for the sequence protocol generated for classes deriving from C++ containers,
+ *  and read-only views returned in place of converted C++ containers.
+ */
+namespace Container
+{
+    /**
+     * Returns a new reference to the next item of the C++ \p container, using the iteration \p state.
+     * Returns null with no Python exception set when there are no more items.
+     */
+    typedef PyObject* (*IteratorNextFunc)(PyObject* container, void* state);
+    /// Destroys the iteration state given to newIterator().
+    typedef void (*IteratorStateDeleter)(void* state);
+
+    /**
+     * Creates a Python iterator over \p container. Items are produced by \p next until it returns
+     * null; the iterator keeps a reference to \p container and owns \p state, which is destroyed
+     * by \p deleteState as soon as the iteration is over.
+     */
+    LIBSHIBOKEN_API PyObject* newIterator(PyObject* container, void* state,
+                                          IteratorNextFunc next, IteratorStateDeleter deleteState);
+
+    /**
+     * Returns the item of \p container for the integer \p key, which may be negative.
+     * Used when a subscript of a container is not a slice.
+     */
+    LIBSHIBOKEN_API PyObject* getIndexedItem(PyObject* container, PyObject* key);
+
+    /**
+     * Fills the indexes and the number of items of the \p slice of a container of \p length items.
+     * Returns false and sets a Python exception if \p slice is invalid.
+     */
+    LIBSHIBOKEN_API bool sliceIndices(PyObject* slice, Py_ssize_t length, Py_ssize_t* start,
+                                      Py_ssize_t* stop, Py_ssize_t* step, Py_ssize_t* sliceLength);
+
+    /**
+     * State of a Python iteration over a class derived from the C++ \p Container.
+     * Containers without random access iterators are copied when the iteration starts:
+     * an iterator kept on the wrapped container could point to a node freed by Python
+     * code run between two steps, without any way to notice it.
+     */
+    template<typename Container,
+             typename Category = typename std::iterator_traits<typename Container::const_iterator>::iterator_category>
+    class IteratorState
+    {
+    public:
+        typedef std::deque<typename Container::value_type> Items;
+        typedef typename Items::const_iterator ConstIterator;
+
+        explicit IteratorState(const Container& container)
+            : m_items(container.begin(), container.end()), m_size(container.size()), m_pos(0) {}
+
+        /// Returns true if \p container does not have the size it had when the iteration started.
+        bool sizeChanged(const Container& container) const
+        {
+            return container.size() != m_size;
+        }
+
+        /// Points \p item to the next item of the iteration and returns true, or returns false at its end.
+        bool next(const Container&, ConstIterator& item)
+        {
+            if (m_pos >= m_size)
+                return false;
+            item = m_items.begin() + m_pos++;
+            return true;
+        }
+
+    private:
+        const Items m_items;
+        typename Container::size_type m_size;
+        typename Container::size_type m_pos;
+    };
+
+    /**
+     * Random access containers are iterated by position, the item being looked up from
+     * begin() at every step, so reallocations of the storage are harmless.
+     */
+    template<typename Container>
+    class IteratorState<Container, std::random_access_iterator_tag>
+    {
+    public:
+        typedef typename Container::const_iterator ConstIterator;
+
+        explicit IteratorState(const Container& container) : m_size(container.size()), m_pos(0) {}
+
+        bool sizeChanged(const Container& container) const
+        {
+            return container.size() != m_size;
+        }
+
+        bool next(const Container& container, ConstIterator& item)
+        {
+            if (m_pos >= m_size)
+                return false;
+            item = container.begin() + m_pos++;
+            return true;
+        }
+
+    private:
+        typename Container::size_type m_size;
+        typename Container::size_type m_pos;
+    };
+
+    /**
+     * The C++ side of a read-only container view. Items are converted to Python only when
+     * they are accessed.
+     */
+    class LIBSHIBOKEN_API ViewState
+    {
+    public:
+        virtual ~ViewState() {}
+        /// Returns the number of items in the viewed container.
+        virtual Py_ssize_t size() const = 0;
+        /**
+         * Returns a new reference to the item at \p index, which is in the [0, size()) range.
+         * For mapping views it is the key at \p index.
+         */
+        virtual PyObject* item(Py_ssize_t index) = 0;
+        /**
+         * Returns a new reference to the value for \p key on mapping views.
+         * Returns null and sets a KeyError if there is no such key.
+         */
+        virtual PyObject* lookup(PyObject* key);
+        /**
+         * Returns the type name of the state, used to find the C++ container behind a view.
+         * The base implementation returns null, such states are never converted back to C++.
+         */
+        virtual const char* stateTypeName() const;
+    };
+
+    /**
+     * Holds a copy of a C++ container. Sequential accesses step a cached iterator, so
+     * iterating the view is linear even on containers without random access iterators.
+     */
+    template<typename Container>
+    class ContainerViewState : public ViewState
+    {
+    public:
+        typedef typename Container::const_iterator ConstIterator;
+        /// Returns a new reference to the Python conversion of the item pointed by the iterator.
+        typedef PyObject* (*ItemToPythonFunc)(const ConstIterator& it);
+        /// Returns a new reference to the value for a Python key, or null with a KeyError set.
+        typedef PyObject* (*LookupFunc)(const Container& container, PyObject* key);
+
+        ContainerViewState(const Container& container, ItemToPythonFunc itemToPython, LookupFunc lookup = 0)
+            : m_container(container), m_size(m_container.size()), m_cursor(m_container.begin()),
+              m_cursorPos(0), m_itemToPython(itemToPython), m_lookup(lookup) {}
+
+        virtual Py_ssize_t size() const
+        {
+            return m_size;
+        }
+
+        virtual PyObject* item(Py_ssize_t index)
+        {
+            if (index < m_cursorPos) {
+                m_cursor = m_container.begin();
+                m_cursorPos = 0;
+            }
+            std::advance(m_cursor, index - m_cursorPos);
+            m_cursorPos = index;
+            return m_itemToPython(m_cursor);
+        }
+
+        virtual PyObject* lookup(PyObject* key)
+        {
+            if (!m_lookup)
+                return ViewState::lookup(key);
+            return m_lookup(m_container, key);
+        }
+
+        virtual const char* stateTypeName() const
+        {
+            return typeid(ContainerViewState).name();
+        }
+
+        /// Returns the copy of the container held by the view.
+        const Container& container() const
+        {
+            return m_container;
+        }
+
+    private:
+        ContainerViewState(const ContainerViewState&);
+        ContainerViewState& operator=(const ContainerViewState&);
+
+        const Container m_container;
+        Py_ssize_t m_size;
+        ConstIterator m_cursor;
+        Py_ssize_t m_cursorPos;
+        ItemToPythonFunc m_itemToPython;
+        LookupFunc m_lookup;
+    };
+
+    /**
+     * Creates a read-only Python sequence over \p state, which is owned by the view.
+     * The view supports len(), indexes, slices and iteration; slices return lists.
+     */
+    LIBSHIBOKEN_API PyObject* newSequenceView(ViewState* state);
+
+    /**
+     * Creates a read-only Python mapping over \p state, which is owned by the view.
+     * The view supports len(), subscripts, "in", iteration over the keys and the
+     * keys(), values(), items() and get() methods.
+     */
+    LIBSHIBOKEN_API PyObject* newMappingView(ViewState* state);
+
+    /// Creates a read-only sequence view on a copy of \p container.
+    template<typename Container>
+    inline PyObject* newSequenceView(const Container& container,
+                                     typename ContainerViewState<Container>::ItemToPythonFunc itemToPython)
+    {
+        return newSequenceView(new ContainerViewState<Container>(container, itemToPython));
+    }
+
+    /// Creates a read-only mapping view on a copy of \p container.
+    template<typename Container>
+    inline PyObject* newMappingView(const Container& container,
+                                    typename ContainerViewState<Container>::ItemToPythonFunc keyToPython,
+                                    typename ContainerViewState<Container>::LookupFunc lookup)
+    {
+        return newMappingView(new ContainerViewState<Container>(container, keyToPython, lookup));
+    }
+
+    /// Returns the state of \p pyIn if it is a sequence or mapping view, or null otherwise.
+    LIBSHIBOKEN_API ViewState* getViewState(PyObject* pyIn);
+
+    /**
+     * Returns the container held by \p pyIn if it is a view on a \p Container, or null otherwise.
+     * The type names are compared, so the views created by other modules are recognized too.
+     */
+    template<typename Container>
+    inline const Container* viewedContainer(PyObject* pyIn)
+    {
+        ViewState* state = getViewState(pyIn);
+        if (!state || !state->stateTypeName()
+            || std::strcmp(state->stateTypeName(), typeid(ContainerViewState<Container>).name()) != 0)
+            return 0;
+        return &static_cast<ContainerViewState<Container>*>(state)->container();
+    }
+
+} // namespace Container
+} // namespace Shiboken
+
+#endif // SBKCONTAINER_H
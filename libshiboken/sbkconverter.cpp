@@ -24,14 +24,40 @@
 #include "sbkconverter_p.h"
 #include "basewrapper_p.h"
 #include "google/dense_hash_map"
+#include "google/dense_hash_set"
 #include "autodecref.h"
 #include "sbkdbg.h"
+#include "sbkmodule.h"
+#include <cstring>
+#include <vector>
 
 static SbkConverter** PrimitiveTypeConverters;
 
 typedef google::dense_hash_map<std::string, SbkConverter*> ConvertersMap;
 static ConvertersMap converters;
 
+/// Converter names table of a module, as given to registerConverterNames().
+struct ConverterNamesTable
+{
+    PyTypeObject** types;
+    const Shiboken::Conversions::ConverterName* names;
+    int count;
+};
+static std::vector<ConverterNamesTable> converterNamesTables;
+
+/// Type of a module providing a converter name, see registerConverterName(PyTypeObject**, int, const char*).
+struct LazyConverterName
+{
+    PyTypeObject** types;
+    int typeIndex;
+};
+typedef google::dense_hash_map<std::string, LazyConverterName> LazyConverterNamesMap;
+static LazyConverterNamesMap lazyConverterNames;
+
+/// Names known to have no converter, emptied whenever new converter names are registered.
+typedef google::dense_hash_set<std::string> MissingConvertersSet;
+static MissingConvertersSet missingConverters;
+
 namespace Shiboken {
 namespace Conversions {
 
@@ -61,6 +87,10 @@ void init()
     assert(converters.empty());
     converters.set_empty_key("");
     converters.set_deleted_key("?");
+    lazyConverterNames.set_empty_key("");
+    lazyConverterNames.set_deleted_key("?");
+    missingConverters.set_empty_key("");
+    missingConverters.set_deleted_key("?");
     converters["PY_LONG_LONG"] = primitiveTypeConverters[SBK_PY_LONG_LONG_IDX];
     converters["bool"] = primitiveTypeConverters[SBK_BOOL_IDX];
     converters["char"] = primitiveTypeConverters[SBK_CHAR_IDX];
@@ -313,6 +343,51 @@ void registerConverterName(SbkConverter* converter , const char* typeName)
     ConvertersMap::iterator iter = converters.find(typeName);
     if (iter == converters.end())
         converters.insert(std::make_pair(typeName, converter));
+    missingConverters.clear();
+}
+
+void registerConverterName(PyTypeObject** types, int typeIndex, const char* typeName)
+{
+    LazyConverterName entry = { types, typeIndex };
+    lazyConverterNames.insert(std::make_pair(typeName, entry));
+    missingConverters.clear();
+}
+
+void registerConverterNames(PyTypeObject** types, const ConverterName* names)
+{
+    ConverterNamesTable table = { types, names, 0 };
+    while (names[table.count].name)
+        ++table.count;
+    converterNamesTables.push_back(table);
+    missingConverters.clear();
+}
+
+/**
+ *  Looks for \p typeName in the modules' converter names tables. \p found is set to true
+ *  if some table has the name, even if the type providing it has no converter yet.
+ */
+static SbkConverter* findConverterInTables(const char* typeName, bool& found)
+{
+    for (std::size_t i = 0; i < converterNamesTables.size(); ++i) {
+        const ConverterNamesTable& table = converterNamesTables[i];
+        int first = 0;
+        int last = table.count;
+        while (first < last) {
+            int middle = (first + last) / 2;
+            if (std::strcmp(table.names[middle].name, typeName) < 0)
+                first = middle + 1;
+            else
+                last = middle;
+        }
+        if (first == table.count || std::strcmp(table.names[first].name, typeName))
+            continue;
+        found = true;
+        // The type may not be created yet, or not have its converter set up.
+        PyTypeObject* type = Module::getType(table.types, table.names[first].typeIndex);
+        if (type && reinterpret_cast<_SbkGenericType*>(type)->converter)
+            return SBK_CONVERTER(type);
+    }
+    return 0;
 }
 
 SbkConverter* getConverter(const char* typeName)
@@ -320,6 +395,30 @@ SbkConverter* getConverter(const char* typeName)
     ConvertersMap::const_iterator it = converters.find(typeName);
     if (it != converters.end())
         return it->second;
+    if (missingConverters.find(typeName) != missingConverters.end())
+        return 0;
+    bool found = false;
+    // Names resolved through the tables go to the hash, later lookups skip the binary searches.
+    if (SbkConverter* converter = findConverterInTables(typeName, found)) {
+        converters.insert(std::make_pair(typeName, converter));
+        return converter;
+    }
+    // The name may belong to a type not created yet: create only that one, which registers its names.
+    LazyConverterNamesMap::const_iterator lazy = lazyConverterNames.find(typeName);
+    if (lazy != lazyConverterNames.end()) {
+        found = true;
+        PyTypeObject* type = Module::getType(lazy->second.types, lazy->second.typeIndex);
+        it = converters.find(typeName);
+        if (it != converters.end())
+            return it->second;
+        if (type && reinterpret_cast<_SbkGenericType*>(type)->converter) {
+            converters.insert(std::make_pair(typeName, SBK_CONVERTER(type)));
+            return SBK_CONVERTER(type);
+        }
+    }
+    // A type found in a table may still get its converter, only unknown names are remembered.
+    if (!found)
+        missingConverters.insert(typeName);
     if (Py_VerboseFlag > 0)
         SbkDbg() << "Can't find type resolver for type '" << typeName << "'.";
     return 0;
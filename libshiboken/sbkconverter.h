@@ -252,7 +252,35 @@ LIBSHIBOKEN_API bool isImplicitConversion(SbkObjectType* type, PythonToCppFunc t
 /// Registers a converter with a type name that may be used to retrieve the converter.
 LIBSHIBOKEN_API void registerConverterName(SbkConverter* converter, const char* typeName);
 
-/// Returns the converter for a given type name, or NULL if it wasn't registered before.
+/**
+ *  Registers a converter name of a type that a module creates on demand, such as the name
+ *  given by typeid(), which can't be known when generating the module's converter names table.
+ *  Looking up \p typeName creates the type, which must then register the name itself.
+ *  \param types        The module's array of types, see Module::registerLazyTypes().
+ *  \param typeIndex    Index of the type in \p types.
+ */
+LIBSHIBOKEN_API void registerConverterName(PyTypeObject** types, int typeIndex, const char* typeName);
+
+/// Entry of a module's table of converter names, see registerConverterNames().
+struct ConverterName
+{
+    const char* name;
+    /// Index of the type owning the converter in the module's array of types.
+    int typeIndex;
+};
+
+/**
+ *  Registers the names of the converters of a module's wrapper types and enums in one go.
+ *  \param types    The module's array of types, the converter for a name is taken from its type.
+ *  \param names    Table sorted by name, terminated by an entry with a NULL name.
+ *                  It is not copied and must outlive the module.
+ */
+LIBSHIBOKEN_API void registerConverterNames(PyTypeObject** types, const ConverterName* names);
+
+/**
+ *  Returns the converter for a given type name, or NULL if it wasn't registered before.
+ *  \note Like the registration functions above, it must be called with the GIL held.
+ */
 LIBSHIBOKEN_API SbkConverter* getConverter(const char* typeName);
 
 /// Returns the converter for a primitive type.
@@ -401,7 +401,8 @@ struct Primitive<std::string> : TwoPrimitive<std::string>
 {
     static PyObject* toPython(const void* cppIn)
     {
-        return Shiboken::String::fromCString(((std::string*)cppIn)->c_str());
+        const std::string* str = (const std::string*)cppIn;
+        return Shiboken::String::fromStringAndSize(str->data(), str->size());
     }
     static void toCpp(PyObject* pyIn, void* cppOut)
     {
@@ -415,7 +416,12 @@ struct Primitive<std::string> : TwoPrimitive<std::string>
     }
     static void otherToCpp(PyObject* pyIn, void* cppOut)
     {
-        *((std::string*)cppOut) = Shiboken::String::toCString(pyIn);
+        Py_ssize_t len = 0;
+        const char* str = Shiboken::String::toCString(pyIn, &len);
+        if (str)
+            ((std::string*)cppOut)->assign(str, len);
+        else
+            ((std::string*)cppOut)->clear();
     }
     static PythonToCppFunc isOtherConvertible(PyObject* pyIn)
     {
@@ -23,6 +23,11 @@
 #include "sbkmodule.h"
 #include "basewrapper.h"
 #include "bindingmanager.h"
+#include "autodecref.h"
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <vector>
 
 // TODO: for performance reasons this should be a sparse_hash_map,
 // because there'll be very few modules as keys. The sparse_hash_map
@@ -39,6 +44,127 @@ typedef google::dense_hash_map<PyObject*, SbkConverter**> ModuleConvertersMap;
 static ModuleTypesMap moduleTypes;
 static ModuleConvertersMap moduleConverters;
 
+enum LazyTypeInitState {
+    LazyTypeInitPending,
+    LazyTypeInitRunning,
+    LazyTypeInitDone
+};
+
+/// Types of a module registered with registerLazyTypes().
+struct LazyModule
+{
+    PyObject* module;
+    PyTypeObject** types;
+    int typeCount;
+    const Shiboken::Module::LazyTypeInit* inits;
+    const int* initIndexes;
+    std::vector<char> states;
+};
+
+/// This map goes from the types array of a module to its lazy initialization data.
+typedef std::map<PyTypeObject**, LazyModule*> LazyModulesMap;
+static LazyModulesMap lazyModules;
+/// Number of type initializers not yet started, in all modules.
+static int pendingLazyTypeInits = 0;
+
+static LazyModule* findLazyModule(PyObject* module)
+{
+    for (LazyModulesMap::iterator it = lazyModules.begin(); it != lazyModules.end(); ++it) {
+        if (it->second->module == module)
+            return it->second;
+    }
+    return 0;
+}
+
+static void runLazyTypeInit(LazyModule* lazy, int initIndex)
+{
+    if (lazy->states[initIndex] != LazyTypeInitPending)
+        return;
+    lazy->states[initIndex] = LazyTypeInitRunning;
+    --pendingLazyTypeInits;
+    lazy->inits[initIndex].init(lazy->module);
+    lazy->states[initIndex] = LazyTypeInitDone;
+}
+
+static void runLazyTypeInits(LazyModule* lazy)
+{
+    for (std::size_t i = 0; i < lazy->states.size(); ++i)
+        runLazyTypeInit(lazy, i);
+}
+
+#if PY_VERSION_HEX >= 0x03070000
+static PyObject* lazyModuleDir(PyObject* self, PyObject*)
+{
+    PyObject* names = PyDict_Keys(PyModule_GetDict(self));
+    LazyModule* lazy = findLazyModule(self);
+    if (!names || !lazy)
+        return names;
+    for (std::size_t i = 0; i < lazy->states.size(); ++i) {
+        if (lazy->states[i] != LazyTypeInitPending)
+            continue;
+        Shiboken::AutoDecRef name(PyUnicode_FromString(lazy->inits[i].name));
+        PyList_Append(names, name);
+    }
+    return names;
+}
+
+// Module level __getattr__ (PEP 562), only called for names missing from the module dictionary.
+static PyObject* lazyModuleGetAttr(PyObject* self, PyObject* name)
+{
+    const char* attrName = PyUnicode_Check(name) ? PyUnicode_AsUTF8(name) : 0;
+    LazyModule* lazy = attrName ? findLazyModule(self) : 0;
+    if (lazy && !std::strcmp(attrName, "__all__")) {
+        // "from module import *" must see the types not yet created
+        PyObject* names = lazyModuleDir(self, 0);
+        if (!names)
+            return 0;
+        PyObject* publicNames = PyList_New(0);
+        for (Py_ssize_t i = 0; publicNames && i < PyList_GET_SIZE(names); ++i) {
+            PyObject* item = PyList_GET_ITEM(names, i);
+            if (PyUnicode_Check(item) && PyUnicode_AsUTF8(item)[0] != '_')
+                PyList_Append(publicNames, item);
+        }
+        Py_DECREF(names);
+        return publicNames;
+    }
+    if (lazy) {
+        for (std::size_t i = 0; i < lazy->states.size(); ++i) {
+            if (lazy->states[i] != LazyTypeInitPending || std::strcmp(lazy->inits[i].name, attrName))
+                continue;
+            runLazyTypeInit(lazy, i);
+            if (PyErr_Occurred())
+                return 0;
+            PyObject* attr = PyDict_GetItem(PyModule_GetDict(self), name);
+            if (attr) {
+                Py_INCREF(attr);
+                return attr;
+            }
+            break;
+        }
+    }
+    PyErr_Format(PyExc_AttributeError, "module '%s' has no attribute '%S'", PyModule_GetName(self), name);
+    return 0;
+}
+
+static PyMethodDef lazyModuleMethods[] = {
+    {"__getattr__", (PyCFunction)lazyModuleGetAttr, METH_O, 0},
+    {"__dir__", (PyCFunction)lazyModuleDir, METH_NOARGS, 0},
+    {0} // Sentinel
+};
+
+static bool installLazyModuleMethods(PyObject* module)
+{
+    for (PyMethodDef* def = lazyModuleMethods; def->ml_name; ++def) {
+        PyObject* func = PyCFunction_NewEx(def, module, 0);
+        if (!func || PyModule_AddObject(module, def->ml_name, func) < 0) {
+            PyErr_Clear();
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
 namespace Shiboken
 {
 namespace Module
@@ -86,11 +212,68 @@ void registerTypes(PyObject* module, PyTypeObject** types)
 }
 
 PyTypeObject** getTypes(PyObject* module)
+{
+    initializeLazyTypes(module);
+    return getLazyTypes(module);
+}
+
+PyTypeObject** getLazyTypes(PyObject* module)
 {
     ModuleTypesMap::iterator iter = moduleTypes.find(module);
     return (iter == moduleTypes.end()) ? 0 : iter->second;
 }
 
+void registerLazyTypes(PyObject* module, PyTypeObject** types, int typeCount,
+                       const LazyTypeInit* inits, const int* initIndexes)
+{
+    LazyModule* lazy = new LazyModule;
+    lazy->module = module;
+    lazy->types = types;
+    lazy->typeCount = typeCount;
+    lazy->inits = inits;
+    lazy->initIndexes = initIndexes;
+    int initCount = 0;
+    while (inits[initCount].name)
+        ++initCount;
+    lazy->states.resize(initCount, LazyTypeInitPending);
+    pendingLazyTypeInits += initCount;
+    lazyModules[types] = lazy;
+
+#if PY_VERSION_HEX >= 0x03070000
+    const char* eager = std::getenv("SHIBOKEN_EAGER_TYPE_INIT");
+    bool forceEager = eager && *eager && std::strcmp(eager, "0");
+    if (!forceEager && installLazyModuleMethods(module))
+        return;
+#endif
+    runLazyTypeInits(lazy);
+}
+
+void initializeLazyTypes(PyObject* module)
+{
+    if (!pendingLazyTypeInits)
+        return;
+    for (LazyModulesMap::iterator it = lazyModules.begin(); it != lazyModules.end(); ++it) {
+        if (!module || it->second->module == module)
+            runLazyTypeInits(it->second);
+    }
+}
+
+bool hasPendingLazyTypes()
+{
+    return pendingLazyTypeInits > 0;
+}
+
+PyTypeObject* resolveLazyType(PyTypeObject** types, int index)
+{
+    LazyModulesMap::iterator it = lazyModules.find(types);
+    if (it != lazyModules.end()) {
+        LazyModule* lazy = it->second;
+        if (index >= 0 && index < lazy->typeCount && lazy->initIndexes[index] >= 0)
+            runLazyTypeInit(lazy, lazy->initIndexes[index]);
+    }
+    return types[index];
+}
+
 void registerTypeConverters(PyObject* module, SbkConverter** converters)
 {
     ModuleConvertersMap::iterator iter = moduleConverters.find(module);
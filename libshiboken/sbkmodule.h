@@ -74,11 +74,63 @@ LIBSHIBOKEN_API void registerTypes(PyObject* module, PyTypeObject** types);
 
 /**
  *  Retrieves the array of types.
+ *  Types of \p module still waiting for lazy initialization are created before returning.
  *  \param module   Module where the types were created.
  *  \returns        A pointer to the PyTypeObject* array of types.
  */
 LIBSHIBOKEN_API PyTypeObject** getTypes(PyObject* module);
 
+/**
+ *  Retrieves the array of types without creating the ones waiting for lazy initialization,
+ *  the entries of the returned array must be read with getType().
+ *  \param module   Module where the types were created.
+ *  \returns        A pointer to the PyTypeObject* array of types.
+ */
+LIBSHIBOKEN_API PyTypeObject** getLazyTypes(PyObject* module);
+
+/// Creates a top-level type of a module together with its enums and nested types.
+typedef void (*LazyTypeInitFunction)(PyObject* module);
+
+struct LazyTypeInit
+{
+    /// Name of the type in the module.
+    const char* name;
+    LazyTypeInitFunction init;
+};
+
+/**
+ *  Registers the types of \p module to be created on their first use, which may be an access to the
+ *  module attribute, or a getType() call from the bindings. Types are created immediately if the
+ *  Python version lacks module level __getattr__ support, or SHIBOKEN_EAGER_TYPE_INIT is set in
+ *  the environment.
+ *  \param module       Module where the types will be created.
+ *  \param types        Array of PyTypeObject* objects of \p module, lazily initialized entries are NULL.
+ *  \param typeCount    Size of \p types.
+ *  \param inits        Array of type initializers, terminated by an entry with a NULL name.
+ *  \param initIndexes  For each entry of \p types, the index in \p inits of the function creating it, or -1.
+ */
+LIBSHIBOKEN_API void registerLazyTypes(PyObject* module, PyTypeObject** types, int typeCount,
+                                       const LazyTypeInit* inits, const int* initIndexes);
+
+/**
+ *  Creates all types of \p module still waiting for lazy initialization.
+ *  \param module   A module, or NULL for all the modules.
+ */
+LIBSHIBOKEN_API void initializeLazyTypes(PyObject* module = 0);
+
+/// Returns true if any module has types still waiting for lazy initialization.
+LIBSHIBOKEN_API bool hasPendingLazyTypes();
+
+/// Creates the type at \p index of a types array registered with registerLazyTypes().
+LIBSHIBOKEN_API PyTypeObject* resolveLazyType(PyTypeObject** types, int index);
+
+/// Returns the type at \p index of \p types, creating it if it was registered for lazy initialization.
+inline PyTypeObject* getType(PyTypeObject** types, int index)
+{
+    PyTypeObject* type = types[index];
+    return type ? type : resolveLazyType(types, index);
+}
+
 /**
  *  Registers the list of converters created by \p module for non-wrapper types.
  *  \param module       Module where the converters were created.
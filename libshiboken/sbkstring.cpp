@@ -21,7 +21,6 @@
  */
 
 #include "sbkstring.h"
-#include "autodecref.h"
 
 namespace Shiboken
 {
@@ -84,14 +83,13 @@ const char* toCString(PyObject* str, Py_ssize_t* len)
         return NULL;
 #ifdef IS_PY3K
     if (PyUnicode_Check(str)) {
-        if (len) {
-            // We need to encode the unicode string into utf8 to know the size of returned char*.
-            Shiboken::AutoDecRef uniStr(PyUnicode_AsUTF8String(str));
-            *len = PyBytes_GET_SIZE(uniStr.object());
-        }
-        // Return unicode from str instead of uniStr, because the lifetime of the returned pointer
-        // depends on the lifetime of str.
-        return _PyUnicode_AsString(str);
+        // The UTF-8 encoding is cached in str, so the string is encoded only once and the returned
+        // pointer lives as long as str.
+#if PY_VERSION_HEX >= 0x03030000
+        return PyUnicode_AsUTF8AndSize(str, len);
+#else
+        return _PyUnicode_AsStringAndSize(str, len);
+#endif
     }
 #endif
     if (PyBytes_Check(str)) {
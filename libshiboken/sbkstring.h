@@ -42,6 +42,10 @@ namespace String
     LIBSHIBOKEN_API bool isConvertible(PyObject* obj);
     LIBSHIBOKEN_API PyObject* fromCString(const char* value);
     LIBSHIBOKEN_API PyObject* fromCString(const char* value, int len);
+    /**
+     *  Returns the contents of \p str encoded in UTF-8, and its size in bytes on \p len.
+     *  The buffer is owned by \p str and must not be used after it is destroyed.
+     */
     LIBSHIBOKEN_API const char* toCString(PyObject* str, Py_ssize_t* len = 0);
     LIBSHIBOKEN_API bool concat(PyObject** val1, PyObject* val2);
     LIBSHIBOKEN_API PyObject* fromFormat(const char* format, ...);
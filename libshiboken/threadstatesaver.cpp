@@ -25,6 +25,31 @@
 namespace Shiboken
 {
 
+// Once threads are initialized they stay so, only the negative answer must be asked again.
+static bool threadsInitialized()
+{
+    static bool initialized = false;
+    if (!initialized)
+        initialized = PyEval_ThreadsInitialized();
+    return initialized;
+}
+
+static bool holdsGil()
+{
+#if PY_VERSION_HEX >= 0x03040000
+    return PyGILState_Check();
+#else
+    PyThreadState* tstate = PyGILState_GetThisThreadState();
+    // Not PyThreadState_GET(), which is a fatal error without a current thread state in debug builds.
+#  if PY_VERSION_HEX >= 0x03020000
+    PyThreadState* current = reinterpret_cast<PyThreadState*>(_Py_atomic_load_relaxed(&_PyThreadState_Current));
+#  else
+    PyThreadState* current = _PyThreadState_Current;
+#  endif
+    return tstate && tstate == current;
+#endif
+}
+
 ThreadStateSaver::ThreadStateSaver()
         : m_threadState(0)
     {}
@@ -36,7 +61,7 @@ ThreadStateSaver::~ThreadStateSaver()
 
 void ThreadStateSaver::save()
 {
-    if (PyEval_ThreadsInitialized())
+    if (threadsInitialized())
         m_threadState = PyEval_SaveThread();
 }
 
@@ -48,5 +73,18 @@ void ThreadStateSaver::restore()
     }
 }
 
+AllowThreads::AllowThreads()
+    : m_threadState(0)
+{
+    if (threadsInitialized() && holdsGil())
+        m_threadState = PyEval_SaveThread();
+}
+
+AllowThreads::~AllowThreads()
+{
+    if (m_threadState)
+        PyEval_RestoreThread(m_threadState);
+}
+
 } // namespace Shiboken
 
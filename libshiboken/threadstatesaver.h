@@ -29,6 +29,10 @@
 namespace Shiboken
 {
 
+/**
+ *   Releases the GIL between save() and restore(). The destructor restores
+ *   the thread state if it is still saved.
+ */
 class LIBSHIBOKEN_API ThreadStateSaver
 {
 public:
@@ -43,6 +47,32 @@ private:
     ThreadStateSaver& operator=(const ThreadStateSaver&);
 };
 
+/**
+ *   Releases the GIL for the whole scope of the object, for injected code that
+ *   runs several blocking C++ calls in a row:
+ *
+ *   \code
+ *   {
+ *       Shiboken::AllowThreads allowThreads;
+ *       %CPPSELF.lock();
+ *       %CPPSELF.wait();
+ *   }
+ *   \endcode
+ *
+ *   Nothing is done if the current thread doesn't hold the GIL.
+ */
+class LIBSHIBOKEN_API AllowThreads
+{
+public:
+    AllowThreads();
+    ~AllowThreads();
+private:
+    PyThreadState* m_threadState;
+
+    AllowThreads(const AllowThreads&);
+    AllowThreads& operator=(const AllowThreads&);
+};
+
 } // namespace Shiboken
 
 #endif // THREADSTATESAVER_H
@@ -131,6 +131,7 @@ static bool processProjectFile(QFile& projectFile, QMap<QString, QString>& args)
     QStringList includePaths;
     QStringList typesystemPaths;
     QStringList apiVersions;
+    QStringList headerFiles;
 
     while (!projectFile.atEnd()) {
         line = projectFile.readLine().trimmed();
@@ -154,13 +155,16 @@ static bool processProjectFile(QFile& projectFile, QMap<QString, QString>& args)
         else if (key == "api-version")
             apiVersions << value;
         else if (key == "header-file")
-            args["arg-1"] = value;
+            headerFiles << QDir::toNativeSeparators(value);
         else if (key == "typesystem-file")
             args["arg-2"] = value;
         else
             args[key] = value;
     }
 
+    if (!headerFiles.isEmpty())
+        args["arg-1"] = headerFiles.join(PATH_SPLITTER);
+
     if (!includePaths.isEmpty())
         args["include-paths"] = includePaths.join(PATH_SPLITTER);
 
@@ -242,7 +246,7 @@ void printUsage(const GeneratorList& generators, const QString& generatorName)
     QTextStream s(stdout);
     s << "Usage:\n  "
       << (generatorName.isEmpty() ? "generator" : generatorName)
-      << " [options] header-file typesystem-file\n\n"
+      << " [options] header-file[" PATH_SPLITTER "header-file" PATH_SPLITTER "...] typesystem-file\n\n"
       << "General options:\n";
     QMap<QString, QString> generalOptions;
     generalOptions.insert("project-file=<file>", "text file containing a description of the binding project. Replaces and overrides command line arguments");
@@ -457,7 +461,7 @@ int main(int argc, char *argv[])
         return EXIT_FAILURE;
     }
 
-    extractor.setCppFileName(cppFileName);
+    extractor.setCppFileNames(cppFileName.split(PATH_SPLITTER, QString::SkipEmptyParts));
     extractor.setTypeSystem(typeSystemFileName);
     if (!extractor.run())
         return EXIT_FAILURE;
@@ -0,0 +1,164 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Times the allow-thread methods of the 'sample' binding from several threads.
+
+Usage: allowthreads_benchmark.py [sample binding directory]
+
+Each locker thread blocks in a C++ call that releases the GIL while its
+unlocker thread, running Python code, waits for the lock and releases it.
+Three cases are timed: Bucket.lock(), the C++ virtualBlockerMethod() and a
+Python reimplementation of virtualBlockerMethod() called from C++, which has
+to take the GIL back from inside the released section.
+
+A fourth case times calls from Python threads to a C++ method that calls a
+Python override back. These threads already hold the GIL, so the generated
+virtual method must not call PyGILState_Ensure/Release; the overrides
+count their calls to check that every one of them reached Python.
+
+The number of thread pairs and of rounds per pair are taken from the
+ALLOWTHREADS_BENCHMARK_THREADS (default: 4) and ALLOWTHREADS_BENCHMARK_ROUNDS
+(default: 200) environment variables.'''
+
+import os
+import sys
+import threading
+import time
+
+if len(sys.argv) > 1:
+    sys.path.insert(0, sys.argv[1])
+
+from sample import Bucket, VirtualMethods
+
+
+class MyBucket(Bucket):
+
+    def virtualBlockerMethod(self):
+        self.lock()
+        return True
+
+
+class Unlocker(threading.Thread):
+
+    def __init__(self, bucket, rounds):
+        threading.Thread.__init__(self)
+        self.bucket = bucket
+        self.rounds = rounds
+
+    def run(self):
+        for i in range(self.rounds):
+            while not self.bucket.locked():
+                pass
+            self.bucket.unlock()
+
+
+class Locker(threading.Thread):
+
+    def __init__(self, bucket, rounds, blocker):
+        threading.Thread.__init__(self)
+        self.bucket = bucket
+        self.rounds = rounds
+        self.blocker = blocker
+
+    def run(self):
+        for i in range(self.rounds):
+            self.blocker(self.bucket)
+
+
+class CountingVirtualMethods(VirtualMethods):
+
+    def __init__(self):
+        VirtualMethods.__init__(self)
+        self.calls = 0
+
+    def sumThree(self, a0, a1, a2):
+        self.calls += 1
+        return a0 + a1 + a2
+
+
+class Caller(threading.Thread):
+
+    def __init__(self, rounds):
+        threading.Thread.__init__(self)
+        self.rounds = rounds
+        self.obj = CountingVirtualMethods()
+
+    def run(self):
+        callSum0 = self.obj.callSum0
+        for i in range(self.rounds):
+            callSum0(1, 2, 3)
+
+
+def runCallbacks(name, threads, rounds):
+    workers = [Caller(rounds) for i in range(threads)]
+    start = time.time()
+    for worker in workers:
+        worker.start()
+    for worker in workers:
+        worker.join()
+    elapsed = time.time() - start
+
+    calls = threads * rounds
+    overrideCalls = sum([worker.obj.calls for worker in workers])
+    print('%s: %d threads, %d calls, %d overrides called, %.3fs, %.2f us/call'
+          % (name, threads, calls, overrideCalls, elapsed, elapsed * 1e6 / calls))
+    return overrideCalls == calls
+
+
+def run(name, bucketType, blocker, threads, rounds):
+    workers = []
+    for i in range(threads):
+        bucket = bucketType()
+        workers.append(Locker(bucket, rounds, blocker))
+        workers.append(Unlocker(bucket, rounds))
+
+    start = time.time()
+    for worker in workers:
+        worker.start()
+    for worker in workers:
+        worker.join()
+    elapsed = time.time() - start
+
+    calls = threads * rounds
+    print('%s: %d threads, %d calls, %.3fs, %.1f us/call'
+          % (name, threads, calls, elapsed, elapsed * 1e6 / calls))
+
+
+def main():
+    threads = int(os.environ.get('ALLOWTHREADS_BENCHMARK_THREADS', '4'))
+    rounds = int(os.environ.get('ALLOWTHREADS_BENCHMARK_ROUNDS', '200'))
+
+    run('lock', Bucket, Bucket.lock, threads, rounds)
+    run('virtualBlockerMethod', Bucket,
+        Bucket.callVirtualBlockerMethodButYouDontKnowThis, threads, rounds)
+    run('virtualBlockerMethod (Python override)', MyBucket,
+        Bucket.callVirtualBlockerMethodButYouDontKnowThis, threads, rounds)
+    if not runCallbacks('sumThree (Python override called from Python)', threads, rounds * 1000):
+        return 1
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
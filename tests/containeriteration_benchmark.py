@@ -0,0 +1,71 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Times iterations over a wrapped class deriving from a C++ container.
+
+Usage: containeriteration_benchmark.py [binding directories...]
+
+The directories are added to the module search path, they must provide the
+'sample' module. An IntList, which derives from std::list<int>, is walked
+with a for loop, converted to a Python list and sliced.
+
+The container size is taken from the CONTAINERITERATION_BENCHMARK_SIZE
+environment variable (default: 1000000). Doubling it should roughly double
+the timings.'''
+
+import os
+import sys
+import time
+
+sys.path[0:0] = sys.argv[1:]
+
+from sample import IntList
+
+
+def loop(container):
+    for item in container:
+        pass
+
+
+def timeIt(name, function, container):
+    start = time.time()
+    function(container)
+    elapsed = time.time() - start
+    print('%s (%d items): %.3fs' % (name, len(container), elapsed))
+
+
+def main():
+    size = int(os.environ.get('CONTAINERITERATION_BENCHMARK_SIZE', '1000000'))
+    container = IntList(list(range(size)))
+
+    timeIt('for loop', loop, container)
+    timeIt('list()', list, container)
+    timeIt('full slice', lambda c: c[:], container)
+    timeIt('reversed slice', lambda c: c[::-1], container)
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,72 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Times wrapped methods returning large containers as lists and as views.
+
+Usage: containerview_benchmark.py [binding directories...]
+
+The directories are added to the module search path, they must provide the
+'sample' module. ListUser.getList() converts the whole std::list<int> to a
+Python list, while ListUser.getListView() returns a read-only view converting
+only the items that are accessed.
+
+The container size is taken from the CONTAINERVIEW_BENCHMARK_SIZE environment
+variable (default: 100000), the number of calls from CONTAINERVIEW_BENCHMARK_CALLS
+(default: 100). Only the timings of full conversions should grow with the size.'''
+
+import os
+import sys
+import time
+
+sys.path[0:0] = sys.argv[1:]
+
+from sample import ListUser
+
+
+def timeIt(name, function, calls):
+    start = time.time()
+    for i in range(calls):
+        function()
+    elapsed = time.time() - start
+    print('%s (%d calls): %.3fs' % (name, calls, elapsed))
+
+
+def main():
+    size = int(os.environ.get('CONTAINERVIEW_BENCHMARK_SIZE', '100000'))
+    calls = int(os.environ.get('CONTAINERVIEW_BENCHMARK_CALLS', '100'))
+    lu = ListUser()
+    lu.setList(list(range(size)))
+
+    timeIt('list: len()', lambda: len(lu.getList()), calls)
+    timeIt('view: len()', lambda: len(lu.getListView()), calls)
+    timeIt('list: first item', lambda: lu.getList()[0], calls)
+    timeIt('view: first item', lambda: lu.getListView()[0], calls)
+    timeIt('list: list()', lambda: list(lu.getList()), calls)
+    timeIt('view: list()', lambda: list(lu.getListView()), calls)
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,80 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Times garbage collections with many live wrappers.
+
+Usage: gc_benchmark.py [binding directories...]
+
+The directories are added to the module search path, they must provide the
+'sample' module. A full gc.collect() is timed while holding a list of:
+
+  - leaf value type wrappers, which are not tracked by the garbage collector;
+  - wrappers with an instance dictionary, which are;
+  - instances of a Python subclass, which always are.
+
+The number of live wrappers is taken from the GC_BENCHMARK_WRAPPERS
+environment variable (default: 1000000).'''
+
+import gc
+import os
+import sys
+import time
+
+sys.path[0:0] = sys.argv[1:]
+
+from sample import Point
+
+
+class PyPoint(Point):
+    pass
+
+
+def withDict(x, y):
+    p = Point(x, y)
+    p.label = None
+    return p
+
+
+def timeIt(name, factory, size):
+    objects = [factory(i, i) for i in range(size)]
+    gc.collect()
+    start = time.time()
+    gc.collect()
+    elapsed = time.time() - start
+    print('%s (%d wrappers): %.3fs' % (name, size, elapsed))
+    del objects
+
+
+def main():
+    size = int(os.environ.get('GC_BENCHMARK_WRAPPERS', '1000000'))
+
+    timeIt('leaf wrappers', Point, size)
+    timeIt('instance dictionaries', withDict, size)
+    timeIt('Python subclass', PyPoint, size)
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,62 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Runs a generator command line several times and reports its wall clock time.
+
+Usage: generator_benchmark.py <generator> [generator arguments...]
+
+The number of runs is taken from the GENERATOR_BENCHMARK_RUNS environment
+variable (default: 5). The generator only rewrites files whose contents
+changed, so running it over an already generated binding is harmless.'''
+
+import os
+import subprocess
+import sys
+import time
+
+def main(argv):
+    if len(argv) < 2:
+        sys.stderr.write(__doc__ + '\n')
+        return 2
+
+    runs = int(os.environ.get('GENERATOR_BENCHMARK_RUNS', '5'))
+    devnull = open(os.devnull, 'w')
+    timings = []
+    for i in range(runs):
+        start = time.time()
+        result = subprocess.call(argv[1:], stdout=devnull, stderr=devnull)
+        timings.append(time.time() - start)
+        if result != 0:
+            sys.stderr.write('Generator failed with exit code %d\n' % result)
+            return result
+
+    timings.sort()
+    print('%s: %d runs, best %.3fs, median %.3fs, worst %.3fs'
+          % (os.path.basename(argv[1]), runs, timings[0], timings[len(timings) // 2], timings[-1]))
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
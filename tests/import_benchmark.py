@@ -0,0 +1,91 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Compares the import time of the sample module with eager and lazy type initialization.
+
+Usage: import_benchmark.py [binding directories...]
+
+The directories are added to the module search path of the child
+interpreters, they must provide the 'sample' module, which is generated
+with --enable-lazy-type-init. Each import runs in a fresh interpreter;
+the eager imports set SHIBOKEN_EAGER_TYPE_INIT=1. Besides the import itself,
+the time to then use one class, and to create all of them through
+dir(), is reported.
+
+The number of imports of each kind is taken from the IMPORT_BENCHMARK_RUNS
+environment variable (default: 20), the best and median times are printed.
+Lazy type initialization needs Python 3.7, older versions import eagerly
+in both cases.'''
+
+import os
+import subprocess
+import sys
+
+CHILD_CODE = '''
+import time
+start = time.time()
+import sample
+imported = time.time()
+sample.ObjectType()
+used = time.time()
+[getattr(sample, name) for name in dir(sample)]
+everything = time.time()
+print('%f %f %f' % (imported - start, used - start, everything - start))
+'''
+
+PHASES = ('import', 'import and use one class', 'import and create all types')
+
+
+def timeImports(runs, eager):
+    env = dict(os.environ)
+    env['PYTHONPATH'] = os.pathsep.join(sys.argv[1:] + [env.get('PYTHONPATH', '')])
+    if eager:
+        env['SHIBOKEN_EAGER_TYPE_INIT'] = '1'
+    else:
+        env.pop('SHIBOKEN_EAGER_TYPE_INIT', None)
+    timings = [[] for phase in PHASES]
+    for run in range(runs):
+        output = subprocess.check_output([sys.executable, '-c', CHILD_CODE], env=env)
+        for phase, value in enumerate(output.split()):
+            timings[phase].append(float(value))
+    return timings
+
+
+def report(name, timings):
+    for phase, values in zip(PHASES, timings):
+        values.sort()
+        print('%s, %s: best %.2fms, median %.2fms'
+              % (name, phase, values[0] * 1000, values[len(values) // 2] * 1000))
+
+
+def main():
+    runs = int(os.environ.get('IMPORT_BENCHMARK_RUNS', '20'))
+    report('eager', timeImports(runs, True))
+    report('lazy', timeImports(runs, False))
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
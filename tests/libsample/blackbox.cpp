@@ -48,6 +48,16 @@ BlackBox::keepObjectType(ObjectType* object)
     return m_ticket;
 }
 
+std::list<int>
+BlackBox::keepObjectTypes(const std::list<ObjectType*>& objects)
+{
+    std::list<int> tickets;
+    std::list<ObjectType*>::const_iterator it;
+    for (it = objects.begin(); it != objects.end(); ++it)
+        tickets.push_back(keepObjectType(*it));
+    return tickets;
+}
+
 ObjectType*
 BlackBox::retrieveObjectType(int ticket)
 {
@@ -38,6 +38,7 @@ public:
     ~BlackBox();
 
     int keepObjectType(ObjectType* object);
+    std::list<int> keepObjectTypes(const std::list<ObjectType*>& objects);
     ObjectType* retrieveObjectType(int ticket);
     void disposeObjectType(int ticket);
 
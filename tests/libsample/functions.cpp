@@ -81,6 +81,12 @@ countCharacters(const char* text)
     return count;
 }
 
+int
+countStringCharacters(const std::string& text)
+{
+    return text.size();
+}
+
 char*
 makeCString()
 {
@@ -25,6 +25,7 @@
 
 #include "libsamplemacros.h"
 #include <list>
+#include <string>
 #include <utility>
 #include "oddbool.h"
 #include "complex.h"
@@ -50,6 +51,7 @@ LIBSAMPLE_API std::list<Complex> gimmeComplexList();
 LIBSAMPLE_API Complex sumComplexPair(std::pair<Complex, Complex> cpx_pair);
 
 LIBSAMPLE_API int countCharacters(const char* text);
+LIBSAMPLE_API int countStringCharacters(const std::string& text);
 LIBSAMPLE_API char* makeCString();
 LIBSAMPLE_API const char* returnCString();
 
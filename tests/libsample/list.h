@@ -24,6 +24,7 @@
 #define LIST_H
 
 #include <list>
+#include <iterator>
 #include "libsamplemacros.h"
 #include "point.h"
 
@@ -50,6 +51,17 @@ public:
     inline IntList(const List<int>& lst) : List<int>(lst), m_ctorUsed(ListOfIntCtor) {}
 
     inline void append(int v) { insert(end(), v); }
+    // Replaces the first node, so begin() changes while the size stays the same.
+    inline void replaceFront(int v) { pop_front(); push_front(v); }
+    // Moves the item at index to the end of the list, freeing its node while the size and begin() stay the same.
+    inline void moveToBack(int index)
+    {
+        iterator it = begin();
+        std::advance(it, index);
+        int v = *it;
+        erase(it);
+        push_back(v);
+    }
     CtorEnum constructorUsed() { return m_ctorUsed; }
 private:
     CtorEnum m_ctorUsed;
@@ -59,6 +59,8 @@ public:
 
     inline void setList(std::list<int> lst) { m_lst = lst; }
     inline std::list<int> getList() { return m_lst; }
+    // Returned to Python as a read-only view.
+    inline std::list<int> getListView() { return m_lst; }
 
 private:
     std::list<int> m_lst;
@@ -32,6 +32,12 @@
 
 #include "libsamplemacros.h"
 
+// Given to Python as a read-only mapping view, see its container-type.
+template<class K, class V>
+class Map : public std::map<K, V>
+{
+};
+
 class LIBSAMPLE_API MapUser
 {
 public:
@@ -45,6 +51,13 @@ public:
 
     inline void setMap(std::map<std::string, std::list<int> > map) { m_map = map; }
     inline std::map<std::string, std::list<int> > getMap() { return m_map; }
+    // Returned to Python as a read-only view.
+    inline std::map<std::string, std::list<int> > getMapView() { return m_map; }
+
+    inline void setViewedMap(const Map<std::string, int>& map) { m_viewedMap = map; }
+    inline Map<std::string, int> getViewedMap() { return m_viewedMap; }
+    virtual Map<std::string, int> passViewedMap(const Map<std::string, int>& map) { return map; }
+    inline Map<std::string, int> callPassViewedMap(const Map<std::string, int>& map) { return passViewedMap(map); }
 
     // Compile test
     static void pointerToMap(std::map<std::string, std::string>* arg) {}
@@ -54,6 +67,7 @@ public:
 
 private:
     std::map<std::string, std::list<int> > m_map;
+    Map<std::string, int> m_viewedMap;
 };
 
 #endif // MAPUSER_H
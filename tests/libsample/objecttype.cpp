@@ -127,6 +127,13 @@ ObjectType::setParent(ObjectType* parent)
         m_parent->m_children.push_back(this);
 }
 
+void
+ObjectType::addChildren(const ObjectTypeList& children)
+{
+    for (ObjectTypeList::const_iterator it = children.begin(); it != children.end(); ++it)
+        (*it)->setParent(this);
+}
+
 void
 ObjectType::setObjectName(const Str& name)
 {
@@ -61,6 +61,7 @@ public:
     void setParent(ObjectType* parent);
     inline ObjectType* parent() const { return m_parent; }
     inline const ObjectTypeList& children() const { return m_children; }
+    void addChildren(const ObjectTypeList& children);
     void killChild(const Str& name);
     void removeChild(ObjectType* child);
     ObjectType* takeChild(ObjectType* child);
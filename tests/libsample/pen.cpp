@@ -47,11 +47,11 @@ Pen::Pen(SampleNamespace::Option option) : m_ctor(EnumCtor)
 {
 }
 
-Pen::Pen(const Color& color) : m_ctor(ColorCtor)
+Pen::Pen(const Color& color) : m_ctor(ColorCtor), m_color(color)
 {
 }
 
-Pen::Pen(const Pen& pen) : m_ctor(CopyCtor)
+Pen::Pen(const Pen& pen) : m_ctor(CopyCtor), m_color(pen.m_color)
 {
 }
 
@@ -59,3 +59,8 @@ int Pen::ctorType()
 {
     return m_ctor;
 }
+
+Color Pen::getColor() const
+{
+    return m_color;
+}
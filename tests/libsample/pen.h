@@ -49,8 +49,11 @@ public:
     Pen(const Pen& pen);
 
     int ctorType();
+
+    Color getColor() const;
 private:
     int m_ctor;
+    Color m_color;
 };
 
 #endif
@@ -0,0 +1,81 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Times calls to a trivial wrapped method, mostly measuring the cost of
+finding the C++ object held by self.
+
+Usage: methodcall_benchmark.py [binding directories...]
+
+The directories are added to the module search path, they must provide the
+'sample' module. The same method is called on instances of:
+
+  - a wrapped class with single inheritance;
+  - a Python subclass of it;
+  - a wrapped class with multiple inheritance, which needs a special cast;
+  - a Python class inheriting from two wrapped C++ classes.
+
+The number of calls is taken from the METHODCALL_BENCHMARK_CALLS
+environment variable (default: 1000000).'''
+
+import os
+import sys
+import time
+
+sys.path[0:0] = sys.argv[1:]
+
+from sample import ObjectType, ObjectTypeDerived, Str
+
+
+class PyObjectType(ObjectType):
+    pass
+
+
+class MixedObjectType(ObjectType, Str):
+    def __init__(self):
+        ObjectType.__init__(self)
+        Str.__init__(self)
+
+
+def timeIt(name, obj, calls):
+    callId = obj.callId
+    start = time.time()
+    for i in range(calls):
+        callId()
+    elapsed = time.time() - start
+    print('%s: %.3fs (%.1f ns/call)' % (name, elapsed, elapsed * 1e9 / calls))
+
+
+def main():
+    calls = int(os.environ.get('METHODCALL_BENCHMARK_CALLS', '1000000'))
+
+    timeIt('single inheritance', ObjectType(), calls)
+    timeIt('Python subclass', PyObjectType(), calls)
+    timeIt('multiple inheritance', ObjectTypeDerived(), calls)
+    timeIt('mixed C++ bases', MixedObjectType(), calls)
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,73 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for a module generated with --enable-lazy-type-init.'''
+
+import os
+import sys
+import unittest
+import minimal
+
+LAZY = sys.version_info >= (3, 7) and os.environ.get('SHIBOKEN_EAGER_TYPE_INIT', '0') in ('', '0')
+NAMES_AT_IMPORT = set(minimal.__dict__)
+
+
+class LazyTypeInitTest(unittest.TestCase):
+
+    def testTypesNotCreatedAtImport(self):
+        if LAZY:
+            self.assertFalse('Val' in NAMES_AT_IMPORT)
+            self.assertFalse('Obj' in NAMES_AT_IMPORT)
+        else:
+            self.assertTrue('Val' in NAMES_AT_IMPORT)
+
+    def testTypeCreatedByConversion(self):
+        '''A returned value gets its type even if it was never looked up in the module.'''
+        vals = minimal.ListUser().callCreateValList(2)
+        self.assertTrue('Val' in minimal.__dict__)
+        self.assertEqual(type(vals[0]), minimal.Val)
+
+    def testModuleAttributes(self):
+        names = dir(minimal)
+        for name in ('Obj', 'Val', 'ListUser', 'MinBoolUser'):
+            self.assertTrue(name in names)
+            self.assertTrue(isinstance(getattr(minimal, name), type))
+
+    def testEnumOfLazyType(self):
+        val = minimal.Val(1)
+        self.assertEqual(val.oneOrTheOtherEnumValue(minimal.Val.One), minimal.Val.Other)
+
+    def testStarImport(self):
+        namespace = {}
+        exec('from minimal import *', namespace)
+        self.assertTrue('Obj' in namespace)
+
+    def testMissingAttribute(self):
+        self.assertRaises(AttributeError, getattr, minimal, 'NoSuchType')
+
+
+if __name__ == '__main__':
+    unittest.main()
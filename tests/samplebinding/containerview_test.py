@@ -0,0 +1,194 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+
+'''Test cases for containers returned to Python as read-only views.'''
+
+import unittest
+
+from sample import ListUser, MapUser, ObjectType, ObjectTypeLayout
+
+class SequenceViewTest(unittest.TestCase):
+    '''Test case for a std::list<int> returned as a view.'''
+
+    def setUp(self):
+        self.lu = ListUser()
+        self.lu.setList(list(range(10)))
+        self.view = self.lu.getListView()
+
+    def tearDown(self):
+        del self.view
+        del self.lu
+
+    def testLength(self):
+        self.assertEqual(len(self.view), 10)
+
+    def testIndexes(self):
+        self.assertEqual(self.view[0], 0)
+        self.assertEqual(self.view[7], 7)
+        self.assertEqual(self.view[3], 3)
+        self.assertEqual(self.view[-1], 9)
+        self.assertRaises(IndexError, self.view.__getitem__, 10)
+        self.assertRaises(TypeError, self.view.__getitem__, 'a')
+
+    def testSlices(self):
+        self.assertEqual(self.view[2:5], [2, 3, 4])
+        self.assertEqual(self.view[::-3], [9, 6, 3, 0])
+        self.assertEqual(self.view[20:], [])
+
+    def testIteration(self):
+        self.assertEqual([item for item in self.view], list(range(10)))
+        self.assertEqual(list(self.view), list(range(10)))
+        self.assertTrue(5 in self.view)
+        self.assertEqual(self.view, list(range(10)))
+
+    def testReadOnly(self):
+        def setItem():
+            self.view[0] = 1
+        self.assertRaises(TypeError, setItem)
+
+    def testViewHoldsItsOwnCopy(self):
+        self.lu.setList([1, 2])
+        self.assertEqual(len(self.view), 10)
+        self.assertEqual(list(self.lu.getListView()), [1, 2])
+        del self.lu
+        self.assertEqual(self.view[9], 9)
+
+    def testEmptyContainer(self):
+        view = ListUser().getListView()
+        self.assertEqual(len(view), 0)
+        self.assertEqual(list(view), [])
+        self.assertRaises(IndexError, view.__getitem__, 0)
+
+
+class MappingViewTest(unittest.TestCase):
+    '''Test case for a std::map<std::string, std::list<int> > returned as a view.'''
+
+    def setUp(self):
+        self.map = {'odds' : [1, 3, 5], 'evens' : [2, 4, 6], 'primes' : [2, 3, 5]}
+        self.mu = MapUser()
+        self.mu.setMap(self.map)
+        self.view = self.mu.getMapView()
+
+    def tearDown(self):
+        del self.view
+        del self.mu
+
+    def testLength(self):
+        self.assertEqual(len(self.view), 3)
+
+    def testSubscript(self):
+        self.assertEqual(self.view['odds'], [1, 3, 5])
+        self.assertRaises(KeyError, self.view.__getitem__, 'negatives')
+        self.assertRaises(KeyError, self.view.__getitem__, 1)
+
+    def testContains(self):
+        self.assertTrue('evens' in self.view)
+        self.assertFalse('negatives' in self.view)
+        self.assertFalse(1 in self.view)
+
+    def testMethods(self):
+        self.assertEqual(sorted(self.view.keys()), sorted(self.map.keys()))
+        self.assertEqual(sorted(self.view.values()), sorted(self.map.values()))
+        self.assertEqual(sorted(self.view.items()), sorted(self.map.items()))
+        self.assertEqual(self.view.get('primes'), [2, 3, 5])
+        self.assertEqual(self.view.get('negatives'), None)
+        self.assertEqual(self.view.get('negatives', []), [])
+
+    def testIteration(self):
+        self.assertEqual(sorted(self.view), sorted(self.map))
+        self.assertEqual(dict(self.view), self.map)
+        self.assertEqual(self.view, self.map)
+
+    def testReadOnly(self):
+        def setItem():
+            self.view['odds'] = []
+        self.assertRaises(TypeError, setItem)
+
+
+class MapUserOverride(MapUser):
+    '''MapUser with passViewedMap() overridden, to receive and return views.'''
+
+    def __init__(self):
+        MapUser.__init__(self)
+        self.received = None
+
+    def passViewedMap(self, map):
+        self.received = map
+        return map
+
+
+class ViewConversionTest(unittest.TestCase):
+    '''Test case for views given back to C++.'''
+
+    def testModifiedReturnValue(self):
+        lu = ListUser()
+        lu.setList([1, 2, 3])
+        other = ListUser()
+        other.setList(lu.getListView())
+        self.assertEqual(other.getList(), [1, 2, 3])
+
+        mu = MapUser()
+        mu.setMap({'odds' : [1, 3, 5]})
+        other = MapUser()
+        other.setMap(mu.getMapView())
+        self.assertEqual(other.getMap(), {'odds' : [1, 3, 5]})
+
+    def testContainerType(self):
+        mu = MapUser()
+        mu.setViewedMap({'one' : 1, 'two' : 2})
+        view = mu.getViewedMap()
+        self.assertFalse(isinstance(view, dict))
+        self.assertEqual(view, {'one' : 1, 'two' : 2})
+        other = MapUser()
+        other.setViewedMap(view)
+        self.assertEqual(other.getViewedMap(), {'one' : 1, 'two' : 2})
+
+    def testVirtualOverride(self):
+        mu = MapUserOverride()
+        result = mu.callPassViewedMap({'one' : 1})
+        self.assertFalse(isinstance(mu.received, dict))
+        self.assertEqual(mu.received, {'one' : 1})
+        self.assertEqual(result, {'one' : 1})
+
+    def testViewOfAnotherContainer(self):
+        mu = MapUser()
+        mu.setMap({'odds' : [1, 3, 5]})
+        self.assertRaises(TypeError, mu.setViewedMap, mu.getMapView())
+
+class PointerContainerViewTest(unittest.TestCase):
+    '''Test case for a container of pointers, which is converted instead of viewed.'''
+
+    def testObjectTypeList(self):
+        layout = ObjectTypeLayout()
+        obj = ObjectType()
+        layout.addObject(obj)
+        objects = layout.objects()
+        self.assertTrue(isinstance(objects, list))
+        self.assertEqual(objects, [obj])
+
+if __name__ == '__main__':
+    unittest.main()
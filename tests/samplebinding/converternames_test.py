@@ -0,0 +1,60 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Tests the lookup of converters by name in the tables registered by each module.'''
+
+import unittest
+
+import sample
+import other
+
+class ConverterNamesTest(unittest.TestCase):
+    '''Looks names up with "Shiboken::Conversions::getConverter(typeName)".'''
+
+    def testLazilyCreatedType(self):
+        # Echo is only used here, the lookup creates its type.
+        pyTypes = [sample.getPythonType(name) for name in ('Echo', 'Echo*', 'Echo&')]
+        self.assertEqual(pyTypes, [sample.Echo] * 3)
+
+    def testRepeatedLookup(self):
+        # The second lookup of a name found in a table takes the cached path.
+        self.assertEqual(sample.getPythonType('Derived::SomeInnerClass'), sample.Derived.SomeInnerClass)
+        self.assertEqual(sample.getPythonType('Derived::SomeInnerClass'), sample.Derived.SomeInnerClass)
+
+    def testEnumName(self):
+        self.assertEqual(sample.getPythonType('SampleNamespace::Option'), sample.SampleNamespace.Option)
+
+    def testNamesFromSeveralModules(self):
+        self.assertEqual(sample.getPythonType('OtherObjectType*'), other.OtherObjectType)
+        self.assertEqual(sample.getPythonType('Number'), other.Number)
+        self.assertEqual(sample.getPythonType('ObjectType*'), sample.ObjectType)
+
+    def testUnknownName(self):
+        self.assertEqual(sample.getPythonType('NoSuchType'), None)
+        self.assertEqual(sample.getPythonType('NoSuchType'), None)
+
+if __name__ == '__main__':
+    unittest.main()
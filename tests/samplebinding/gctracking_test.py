@@ -0,0 +1,77 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for the garbage collector tracking of wrappers.'''
+
+import gc
+import unittest
+import weakref
+
+from sample import ObjectModel, ObjectType, ObjectView, Point
+
+class ExtObjectType(ObjectType):
+    pass
+
+class GCTrackingTest(unittest.TestCase):
+    '''Wrappers are only tracked by the garbage collector when they may be part of a cycle.'''
+
+    def testLeafWrapperIsNotTracked(self):
+        self.assertFalse(gc.is_tracked(Point(1, 2)))
+        self.assertFalse(gc.is_tracked(ObjectType()))
+
+    def testInstanceDictionary(self):
+        p = Point(1, 2)
+        p.label = 'origin'
+        self.assert_(gc.is_tracked(p))
+        o = ObjectType()
+        o.__dict__
+        self.assert_(gc.is_tracked(o))
+
+    def testParentWithChildren(self):
+        parent = ObjectType()
+        child = ObjectType()
+        child.setParent(parent)
+        self.assert_(gc.is_tracked(parent))
+        self.assertFalse(gc.is_tracked(child))
+
+    def testKeptReference(self):
+        view = ObjectView()
+        view.setModel(ObjectModel())
+        self.assert_(gc.is_tracked(view))
+
+    def testPythonSubclass(self):
+        self.assert_(gc.is_tracked(ExtObjectType()))
+
+    def testCycleThroughInstanceDictionary(self):
+        o = ObjectType()
+        o.me = o
+        ref = weakref.ref(o)
+        del o
+        gc.collect()
+        self.assertEqual(ref(), None)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -89,5 +89,53 @@ class IntListTest(unittest.TestCase):
         self.assertEqual(il[1], int(432.1))
         self.assertRaises(TypeError, il.__setitem__, 2, '78')
 
+    def testIteration(self):
+        '''IntList objects are iterable.'''
+        ints = [1, 2, 3, 4, 5]
+        il = IntList(ints)
+        self.assertEqual([i for i in il], ints)
+        self.assertEqual(list(IntList()), [])
+        it = iter(il)
+        self.assertEqual(next(it), 1)
+        self.assertEqual(list(it), ints[1:])
+        self.assertRaises(StopIteration, next, it)
+
+    def testIterationWithSizeChange(self):
+        '''Changing the size of an IntList while iterating over it is reported.'''
+        il = IntList([1, 2, 3])
+        it = iter(il)
+        next(it)
+        il.append(4)
+        self.assertRaises(RuntimeError, next, it)
+
+    def testIterationWithReplacedItem(self):
+        '''Iterating over an IntList gives the items it had when the iteration started.'''
+        il = IntList([1, 2, 3])
+        it = iter(il)
+        il.replaceFront(10)
+        self.assertEqual(list(it), [1, 2, 3])
+
+    def testIterationWithMovedItem(self):
+        '''Moving items of an IntList without changing its size keeps the iteration valid.'''
+        il = IntList([1, 2, 3])
+        it = iter(il)
+        self.assertEqual(next(it), 1)
+        il.moveToBack(1)
+        self.assertEqual(list(it), [2, 3])
+        self.assertEqual(list(il), [1, 3, 2])
+
+    def testSlices(self):
+        '''Slices of IntList objects are lists.'''
+        ints = [1, 2, 3, 4, 5]
+        il = IntList(ints)
+        self.assertEqual(il[1:3], ints[1:3])
+        self.assertEqual(il[::2], ints[::2])
+        self.assertEqual(il[::-1], ints[::-1])
+        self.assertEqual(il[4:1:-2], ints[4:1:-2])
+        self.assertEqual(il[10:], [])
+        self.assertEqual(il[-1], 5)
+        self.assertRaises(IndexError, il.__getitem__, 5)
+        self.assertRaises(TypeError, il.__getitem__, 'a')
+
 if __name__ == '__main__':
     unittest.main()
@@ -55,6 +55,11 @@ class ComplexUseCaseReverse(Point, SimpleUseCase2):
         SimpleUseCase2.__init__(self, name)
         Point.__init__(self)
 
+class DerivedUseCase(Str, ObjectModel):
+    def __init__(self, name):
+        Str.__init__(self, name)
+        ObjectModel.__init__(self)
+
 class MultipleCppDerivedTest(unittest.TestCase):
     def testInstanciation(self):
         s = SimpleUseCase("Hi")
@@ -76,6 +81,15 @@ class MultipleCppDerivedTest(unittest.TestCase):
         c.setX(2);
         self.assertEqual(c.x(), 2)
 
+    def testInheritedBaseMethods(self):
+        '''Methods of the C++ bases and of their own bases reach the right C++ object.'''
+        d = DerivedUseCase("Hi")
+        for i in range(3):
+            d.setObjectName(d)
+            self.assertEqual(d.objectName(), "Hi")
+            self.assertEqual(d.cstring(), "Hi")
+            self.assertEqual(ObjectModel.receivesObjectTypeFamily(d), ObjectModel.ObjectModelCalled)
+
 class MultipleCppDerivedReverseTest(unittest.TestCase):
     def testInstanciation(self):
         s = SimpleUseCaseReverse("Hi")
@@ -119,6 +119,24 @@ class ReparentingTest(unittest.TestCase):
         for child in new_parent.children():
             self.assert_(child in object_list)
 
+    def testAddChildrenFromList(self):
+        '''Reparent a list of children, one of them twice, in a single call.'''
+        old_parent = ObjectType()
+        new_parent = ObjectType()
+        object_list = [ObjectType() for i in range(3)]
+        object_list[0].setParent(old_parent)
+        refcounts = [sys.getrefcount(obj) for obj in object_list]
+        new_parent.addChildren(object_list + [object_list[1]])
+        self.assertEqual(new_parent.children(), object_list)
+        self.assertEqual(old_parent.children(), [])
+        # The first child just moved from the old parent, the others got a reference from the new one.
+        self.assertEqual(sys.getrefcount(object_list[0]), refcounts[0])
+        self.assertEqual(sys.getrefcount(object_list[1]), refcounts[1] + 1)
+        self.assertEqual(sys.getrefcount(object_list[2]), refcounts[2] + 1)
+        del new_parent
+        for obj in object_list:
+            self.assertRaises(RuntimeError, obj.objectName)
+
 
 if __name__ == '__main__':
     unittest.main()
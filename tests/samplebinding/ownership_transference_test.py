@@ -31,6 +31,17 @@ import unittest
 
 from sample import ObjectType, BlackBox
 
+class SequenceObjectType(ObjectType):
+    '''An ObjectType that also implements the sequence protocol.'''
+
+    def __len__(self):
+        return 1
+
+    def __getitem__(self, index):
+        if index != 0:
+            raise IndexError(index)
+        return self
+
 class BlackBoxTest(unittest.TestCase):
     '''The BlackBox class has cases of ownership transference between C++ and Python.'''
 
@@ -66,6 +77,21 @@ class BlackBoxTest(unittest.TestCase):
         o3 = bb.retrieveObjectType(-5)
         self.assertEqual(o3, None)
 
+    def testOwnershipTransferenceOfList(self):
+        '''Ownership transference of a list with objects created in Python and in C++.'''
+        o1 = ObjectType()
+        o1_refcnt = sys.getrefcount(o1)
+        o2 = ObjectType.create()
+        o2.setObjectName('object2')
+        bb = BlackBox()
+        tickets = bb.keepObjectTypes([o1, o2])
+        self.assertEqual(len(tickets), 2)
+        self.assertEqual(sys.getrefcount(o1), o1_refcnt + 1)
+        # Objects created in C++ can't be tracked after the ownership transference.
+        self.assertRaises(RuntimeError, o2.objectName)
+        del bb
+        self.assertRaises(RuntimeError, o1.objectName)
+
     def testOwnershipTransferenceCppCreated(self):
         '''Ownership transference using a C++ created object.'''
         o1 = ObjectType.create()
@@ -75,6 +101,29 @@ class BlackBoxTest(unittest.TestCase):
         o1_ticket = bb.keepObjectType(o1)
         self.assertRaises(RuntimeError, o1.objectName)
 
+    def testOwnershipTransferenceOfSequenceWrapper(self):
+        '''Ownership transference of a wrapper whose type implements the sequence protocol.'''
+        o1 = SequenceObjectType()
+        o1.setObjectName('object1')
+        o1_refcnt = sys.getrefcount(o1)
+        bb = BlackBox()
+        o1_ticket = bb.keepObjectType(o1)
+        self.assertEqual(sys.getrefcount(o1), o1_refcnt + 1)
+        o1 = bb.retrieveObjectType(o1_ticket)
+        self.assertEqual(sys.getrefcount(o1), o1_refcnt)
+        self.assertEqual(str(o1.objectName()), 'object1')
+
+    def testOwnershipTransferenceOfListOfSequenceWrappers(self):
+        '''Ownership transference of a list holding wrappers that implement the sequence protocol.'''
+        o1 = SequenceObjectType()
+        o1_refcnt = sys.getrefcount(o1)
+        bb = BlackBox()
+        tickets = bb.keepObjectTypes([o1])
+        self.assertEqual(len(tickets), 1)
+        self.assertEqual(sys.getrefcount(o1), o1_refcnt + 1)
+        del bb
+        self.assertRaises(RuntimeError, o1.objectName)
+
 if __name__ == '__main__':
     unittest.main()
 
@@ -54,6 +54,17 @@ class TestPen(unittest.TestCase):
         pen = Pen(1)
         self.assertEqual(pen.ctorType(), Pen.ColorCtor)
 
+    def testPenColorCopiesAreShared(self):
+        '''Color is a copy-cache value type: equal returned copies share the same wrapper.'''
+        pen = Pen(Color(1))
+        color = pen.getColor()
+        self.assertFalse(color.isNull())
+        self.assert_(pen.getColor() is color)
+        self.assert_(Pen(Color(1)).getColor() is color)
+        nullColor = Pen().getColor()
+        self.assert_(nullColor.isNull())
+        self.assert_(nullColor is not color)
+
 if __name__ == '__main__':
     unittest.main()
 
@@ -0,0 +1,57 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for the conversion of Python strings to 'const char*' and 'std::string' parameters.'''
+
+import sys
+import unittest
+
+from sample import countCharacters, countStringCharacters
+
+class StringConversionTest(unittest.TestCase):
+    '''Test cases for the conversion of Python strings to 'const char*' and 'std::string' parameters.'''
+
+    def testStdString(self):
+        self.assertEqual(countStringCharacters(''), 0)
+        self.assertEqual(countStringCharacters('abc'), 3)
+
+    def testStdStringWithEmbeddedNull(self):
+        '''The whole string reaches C++, not just what comes before the first null character.'''
+        self.assertEqual(countStringCharacters('a\0bc'), 4)
+        self.assertEqual(countCharacters('a\0bc'), 1)
+
+    def testNonAsciiCharacters(self):
+        '''Unicode strings are passed encoded in UTF-8.'''
+        if sys.version_info[0] < 3:
+            return
+        text = 'ção'
+        self.assertEqual(countStringCharacters(text), 5)
+        self.assertEqual(countCharacters(text), 5)
+        # The UTF-8 buffer is cached by the string itself.
+        self.assertEqual(countStringCharacters(text), 5)
+
+if __name__ == '__main__':
+    unittest.main()
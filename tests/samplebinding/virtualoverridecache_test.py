@@ -0,0 +1,99 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2009 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+
+'''Tests that overrides added after a virtual method was called without one are still honoured.'''
+
+import unittest
+
+from sample import VirtualMethods
+
+class SubclassOfVirtualMethods(VirtualMethods):
+    pass
+
+class Mixin(object):
+    pass
+
+class VirtualMethodsWithMixin(Mixin, VirtualMethods):
+    pass
+
+class VirtualOverrideCacheTest(unittest.TestCase):
+    '''Virtual calls remember the methods without a Python override, this must not hide new overrides.'''
+
+    def testInstanceAttributeOverride(self):
+        vm = VirtualMethods()
+        self.assertEqual(vm.callSum0(1, 2, 3), 6)
+        self.assertEqual(vm.callSum0(1, 2, 3), 6)
+        vm.sumThree = lambda a0, a1, a2: 100
+        self.assertEqual(vm.callSum0(1, 2, 3), 100)
+        del vm.sumThree
+        self.assertEqual(vm.callSum0(1, 2, 3), 6)
+
+    def testClassAttributeOverride(self):
+        vm = SubclassOfVirtualMethods()
+        self.assertEqual(vm.callSum0(1, 2, 3), 6)
+        SubclassOfVirtualMethods.sumThree = lambda self, a0, a1, a2: -1
+        try:
+            self.assertEqual(vm.callSum0(1, 2, 3), -1)
+        finally:
+            del SubclassOfVirtualMethods.sumThree
+        self.assertEqual(vm.callSum0(1, 2, 3), 6)
+
+    def testInstanceDictionaryOverride(self):
+        vm = VirtualMethods()
+        self.assertEqual(vm.callSum0(1, 2, 3), 6)
+        vm.__dict__['sumThree'] = lambda a0, a1, a2: 100
+        self.assertEqual(vm.callSum0(1, 2, 3), 100)
+        del vm.__dict__['sumThree']
+        self.assertEqual(vm.callSum0(1, 2, 3), 6)
+
+    def testMixinOverride(self):
+        vm = VirtualMethodsWithMixin()
+        self.assertEqual(vm.callSum0(1, 2, 3), 6)
+        Mixin.sumThree = lambda self, a0, a1, a2: -1
+        try:
+            self.assertEqual(vm.callSum0(1, 2, 3), -1)
+        finally:
+            del Mixin.sumThree
+        self.assertEqual(vm.callSum0(1, 2, 3), 6)
+
+    def testBaseSetAttr(self):
+        vm = SubclassOfVirtualMethods()
+        self.assertEqual(vm.callSum0(1, 2, 3), 6)
+        super(SubclassOfVirtualMethods, vm).__setattr__('label', 'vm')
+        self.assertEqual(vm.label, 'vm')
+        self.assertEqual(vm.callSum0(1, 2, 3), 6)
+        super(SubclassOfVirtualMethods, vm).__setattr__('sumThree', lambda a0, a1, a2: 100)
+        self.assertEqual(vm.callSum0(1, 2, 3), 100)
+
+    def testOverrideAfterInstanceAttribute(self):
+        vm = SubclassOfVirtualMethods()
+        vm.label = 'vm'
+        self.assertEqual(vm.callSum0(1, 2, 3), 6)
+        self.assertEqual(vm.callSum0(1, 2, 3), 6)
+        vm.sumThree = lambda a0, a1, a2: 100
+        self.assertEqual(vm.callSum0(1, 2, 3), 100)
+
+if __name__ == '__main__':
+    unittest.main()
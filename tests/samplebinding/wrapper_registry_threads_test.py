@@ -0,0 +1,117 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Stress test for the wrapper registry: threads creating and retrieving wrappers while others
+delete wrapped objects in C++ without holding the GIL.'''
+
+import sys
+import threading
+import unittest
+
+from sample import ObjectType, Str
+
+THREADS = 8
+ROUNDS = 500
+
+
+class Worker(threading.Thread):
+
+    def __init__(self):
+        threading.Thread.__init__(self)
+        self.errors = []
+
+    def run(self):
+        try:
+            for i in range(ROUNDS):
+                # Wrappers created from C++ returned objects.
+                parent = ObjectType.createWithChild()
+                child = parent.children()[0]
+                # The child wrapper must be found again in the registry, and so must its parent.
+                if parent.children()[0] is not child or child.parent() is not parent:
+                    self.errors.append('wrapper retrieved for round %d differs' % i)
+                # A wrapper created from Python, given to C++ and found back.
+                other = ObjectType()
+                other.setParent(child)
+                if child.children()[0] is not other:
+                    self.errors.append('Python created wrapper lost in round %d' % i)
+                del other, child, parent
+        except Exception as e:
+            self.errors.append(str(e))
+
+
+class Killer(threading.Thread):
+    '''Deletes children created from Python with ObjectType.killChild(), which releases the GIL.'''
+
+    def __init__(self):
+        threading.Thread.__init__(self)
+        self.errors = []
+
+    def run(self):
+        try:
+            for i in range(ROUNDS):
+                parent = ObjectType()
+                for j in range(4):
+                    child = ObjectType(parent)
+                    child.setObjectName(Str('child%d' % j))
+                del child
+                for j in range(4):
+                    parent.killChild(Str('child%d' % j))
+                if parent.children():
+                    self.errors.append('children left alive in round %d' % i)
+                del parent
+        except Exception as e:
+            self.errors.append(str(e))
+
+
+class WrapperRegistryThreadsTest(unittest.TestCase):
+
+    def setUp(self):
+        if hasattr(sys, 'getswitchinterval'):
+            self.interval = sys.getswitchinterval()
+            sys.setswitchinterval(1e-6)
+        else:
+            self.interval = sys.getcheckinterval()
+            sys.setcheckinterval(1)
+
+    def tearDown(self):
+        if hasattr(sys, 'setswitchinterval'):
+            sys.setswitchinterval(self.interval)
+        else:
+            sys.setcheckinterval(self.interval)
+
+    def testConcurrentCreationAndDestruction(self):
+        '''Wrappers created and destroyed from several threads, with and without the GIL, are always found back.'''
+        workers = [Worker() for i in range(THREADS // 2)] + [Killer() for i in range(THREADS // 2)]
+        for worker in workers:
+            worker.start()
+        for worker in workers:
+            worker.join()
+        for worker in workers:
+            self.assertEqual(worker.errors, [])
+
+
+if __name__ == '__main__':
+    unittest.main()
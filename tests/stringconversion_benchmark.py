@@ -0,0 +1,69 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Times calls to wrapped functions taking string arguments.
+
+Usage: stringconversion_benchmark.py [binding directories...]
+
+The directories are added to the module search path, they must provide the
+'sample' module. Functions taking 'const char*' and 'const std::string&'
+are called with short and long strings, both new and reused ones; new
+non-ASCII strings have to be encoded to UTF-8 on their first conversion.
+
+The number of calls is taken from the STRINGCONVERSION_BENCHMARK_CALLS
+environment variable (default: 1000000).'''
+
+import os
+import sys
+import time
+
+sys.path[0:0] = sys.argv[1:]
+
+from sample import countCharacters, countStringCharacters
+
+
+def timeIt(name, function, strings, calls):
+    count = len(strings)
+    start = time.time()
+    for i in range(calls):
+        function(strings[i % count])
+    elapsed = time.time() - start
+    print('%s: %.3fs (%.1f ns/call)' % (name, elapsed, elapsed * 1e9 / calls))
+
+
+def main():
+    calls = int(os.environ.get('STRINGCONVERSION_BENCHMARK_CALLS', '1000000'))
+    short = ['name']
+    longer = ['x' * 4096]
+
+    for name, function in (('const char*', countCharacters), ('std::string', countStringCharacters)):
+        timeIt(name + ', short string', function, short, calls)
+        timeIt(name + ', long string', function, longer, calls)
+        timeIt(name + ', new strings', function, [u'n\xe4me %d' % i for i in range(calls)], calls)
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,96 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Times the teardown of large parent/child trees of wrapped objects.
+
+Usage: wrappertree_benchmark.py [binding directories...]
+
+The directories are added to the module search path, they must provide the
+'sample' and 'shiboken' modules. Three cases are timed on wide trees (one
+parent with many children) and deep trees (a chain of parents):
+
+  - destroy: the Python reference to the root is dropped, destroying the
+    whole tree;
+  - invalidate: shiboken.invalidate() on the root of a tree of objects
+    created in C++;
+  - delete: shiboken.delete() on the root, running the C++ destructors
+    of the whole tree.
+
+The tree sizes are taken from the WRAPPERTREE_BENCHMARK_WIDTH (default:
+100000) and WRAPPERTREE_BENCHMARK_DEPTH (default: 2000) environment
+variables. Doubling them should roughly double the timings.'''
+
+import os
+import sys
+import time
+
+sys.path[0:0] = sys.argv[1:]
+
+import shiboken
+from sample import ObjectType
+
+
+def wideTree(size, factory):
+    root = factory()
+    for i in range(size):
+        factory().setParent(root)
+    return root
+
+
+def deepTree(size, factory):
+    root = factory()
+    parent = root
+    for i in range(size):
+        child = factory()
+        child.setParent(parent)
+        parent = child
+    return root
+
+
+def timeIt(name, shape, size, build, teardown):
+    root = build(size)
+    start = time.time()
+    teardown(root)
+    del root
+    elapsed = time.time() - start
+    print('%s (%s, %d objects): %.3fs' % (name, shape, size + 1, elapsed))
+
+
+def main():
+    width = int(os.environ.get('WRAPPERTREE_BENCHMARK_WIDTH', '100000'))
+    depth = int(os.environ.get('WRAPPERTREE_BENCHMARK_DEPTH', '2000'))
+
+    for shape, size, builder in (('wide', width, wideTree), ('deep', depth, deepTree)):
+        timeIt('destroy', shape, size,
+               lambda n: builder(n, ObjectType), lambda root: None)
+        timeIt('invalidate', shape, size,
+               lambda n: builder(n, ObjectType.create), shiboken.invalidate)
+        timeIt('delete', shape, size,
+               lambda n: builder(n, ObjectType), shiboken.delete)
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())